@@ -0,0 +1,343 @@
+/**********************************************************************************************************************************
+                                            Monomial's Library by Tiago Fernandes Moherdaui
+
+            The library is meant to make operations with monomials easier by use of indicial notation.
+
+            This file provides a class representing dense polynomials in d-dimensions.
+            Each polynomial stores the coefficients of all monomials up to its order, indexed by their monIndex.
+            The following operations are available for polynomials mnl::DensePolynomial<d> p1, p2, p3:
+
+                Polynomial of order k with null coefficients    mnl::DensePolynomial<d> p(k);
+                Order of polynomial                             p1.Order();
+                Addition                                        p3 = p1 + p2; p1 += p2;
+                Multiplication                                  p3 = p1*p2; p1 *= p2;
+                Multiplication with a ProductTable<d, K>        p3 = Multiply(p1, p2, table);
+                Part of p1*p2 up to order K                     p3 = MultiplyTruncated(p1, p2, K);
+                Derivative in x_i                               p3 = p1.D(i);
+                Change of variables, p3(x) = p1(x - c)          p3 = p1.Translate(c);
+                Change of variables, p3(x) = p1(x / h)          p3 = p1.Scale(h);
+                Evaluation at x                                 p1(x);
+                Conversion from and to Polynomial<d>            mnl::DensePolynomial<d> p(sparse); sparse = p.ToSparse();
+
+            The coefficients are stored contiguously in a vector with SpaceDim(p.Order()) entries, directly exposed as:
+            p.Coefficients[alpha] being the coefficient of m_alpha. Null coefficients are kept, as dense polynomials are meant
+            for the case in which most monomials up to the order are present, and the order is the one of the storage.
+
+            Many polynomials of the same order, e.g., one per element of a mesh, are stored together by
+            mnl::DensePolynomialBatch<d> batch(k, count), with batch.Coefficients[alpha * count + e] the coefficient of m_alpha in
+            polynomial e. All their products are computed at once following a precomputed mnl::ProductSchedule<d>, whose entries are
+            multiply-adds of whole rows, vectorized across polynomials with the kernels in smd.hpp:
+
+                Schedule for P_k1 x P_k2 (up to order K)        mnl::ProductSchedule<d> schedule(k1, k2); schedule(k1, k2, K);
+                Products of all polynomials of two batches      MultiplyInto(out, batch1, batch2, schedule);
+                Polynomial e of a batch                         batch.Get(e); batch.Set(e, p);
+
+            Aliases are available for the DensePolynomial<d> struct as dnldD up to d = 9, e.g., DensePolynomial<2> = dnl2D.
+
+            This is produced in C++17 and includes only <algorithm>, <array>, <cassert>, <utility> and <vector>.
+
+**********************************************************************************************************************************/
+#pragma once
+#ifndef DNL
+#define DNL
+#include "mnl.hpp"
+#include "pnl.hpp"
+#include "evl.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace mnl {
+    template <int d>
+    struct DensePolynomial {
+        std::vector<double> Coefficients;
+
+        DensePolynomial() = default;
+        explicit DensePolynomial(const monOrder k) : Coefficients((size_t)Poly<d>::SpaceDim(k), 0.0) {}
+        template<typename Map>
+        explicit DensePolynomial(const Polynomial<d, Map>& p) : DensePolynomial(p.Terms.empty() ? -1 : p.Order()) {
+            for (const auto& it : p.Terms)
+                Coefficients[it.first] = it.second;
+        }
+
+        /************************************************************
+            Order of the storage, -1 for an empty polynomial.
+        ************************************************************/
+        monOrder Order() const {
+            return (Coefficients.empty() ? -1 : Poly<d>::MonOrder((monIndex)Coefficients.size() - 1));
+        }
+
+        DensePolynomial<d>& operator+=(const DensePolynomial<d>& p) {
+            if (p.Coefficients.size() > Coefficients.size())
+                Coefficients.resize(p.Coefficients.size(), 0.0);
+            for (size_t alpha = 0; alpha < p.Coefficients.size(); ++alpha)
+                Coefficients[alpha] += p.Coefficients[alpha];
+            return *this;
+        }
+        DensePolynomial<d>& operator*=(const DensePolynomial<d>& p);
+
+        /************************************************************
+            Derivative in x_i, of order Order() - 1.
+        ************************************************************/
+        DensePolynomial<d> D(const int variable) const {
+            DensePolynomial<d> result(Order() - 1);
+            for (const MonomialEntry<d>& m : Monomials<d>(Order())) {
+                if (m.Exponents[variable] > 0)
+                    result.Coefficients[Poly<d>::D(m.Index, variable)] += m.Exponents[variable] * Coefficients[m.Index];
+            }
+            return result;
+        }
+
+        /************************************************************
+            Polynomial q(x) = p(x - c), of the same order, shifting
+            one variable at a time with binomial coefficients.
+        ************************************************************/
+        DensePolynomial<d> Translate(const std::array<double, d>& c) const {
+            const monOrder k = Order();
+            DensePolynomial<d> result(*this), shifted(k);
+            std::vector<double> powers((size_t)std::max(k, 0) + 1);
+            for (int i = 0; i < d; ++i) {
+                if (c[i] == 0.0)
+                    continue;
+                powers[0] = 1.0;
+                for (size_t m = 1; m < powers.size(); ++m)
+                    powers[m] = -c[i] * powers[m - 1];
+                std::fill(shifted.Coefficients.begin(), shifted.Coefficients.end(), 0.0);
+                for (const MonomialEntry<d>& m : Monomials<d>(k)) {
+                    const double a = result.Coefficients[m.Index];
+                    if (a == 0.0)
+                        continue;
+                    const int n = m.Exponents[i];
+                    monIndex target = m.Index;
+                    for (int j = n; j >= 0; --j) {
+                        shifted.Coefficients[target] += (double)Binomial(n, j) * powers[n - j] * a;
+                        if (j > 0)
+                            target = Poly<d>::D(target, i);
+                    }
+                }
+                result.Coefficients.swap(shifted.Coefficients);
+            }
+            return result;
+        }
+
+        /************************************************************
+            Polynomial q(x) = p(x / h).
+        ************************************************************/
+        DensePolynomial<d> Scale(const double h) const {
+            DensePolynomial<d> result(*this);
+            double power = 1.0;
+            for (monOrder n = 0; n <= Order(); ++n) {
+                for (monIndex alpha = Poly<d>::SpaceDim(n - 1); alpha < Poly<d>::SpaceDim(n); ++alpha)
+                    result.Coefficients[alpha] *= power;
+                power /= h;
+            }
+            return result;
+        }
+
+        /************************************************************
+            Value at x, the monomials being evaluated with
+            EvaluateBasis.
+        ************************************************************/
+        double operator()(const double* x) const {
+            if (Coefficients.empty())
+                return 0.0;
+            std::vector<double> values(Coefficients.size());
+            EvaluateBasis<d>(x, Order(), values.data());
+            double sum = 0.0;
+            for (size_t alpha = 0; alpha < values.size(); ++alpha)
+                sum += Coefficients[alpha] * values[alpha];
+            return sum;
+        }
+        double operator()(const std::array<double, d>& x) const { return (*this)(x.data()); }
+
+        /************************************************************
+            Sparse polynomial with the non-null coefficients.
+        ************************************************************/
+        Polynomial<d> ToSparse() const {
+            Polynomial<d> result;
+            for (size_t alpha = 0; alpha < Coefficients.size(); ++alpha) {
+                if (Coefficients[alpha] != 0.0)
+                    result.Terms[(monIndex)alpha] = Coefficients[alpha];
+            }
+            return result;
+        }
+    };
+
+    template<int d>
+    DensePolynomial<d> operator+(const DensePolynomial<d>& p1, const DensePolynomial<d>& p2) {
+        DensePolynomial<d> result(p1);
+        result += p2;
+        return result;
+    }
+
+    template<int d>
+    DensePolynomial<d> operator*(const DensePolynomial<d>& p1, const DensePolynomial<d>& p2) {
+        if (p1.Coefficients.empty() || p2.Coefficients.empty())
+            return DensePolynomial<d>();
+        DensePolynomial<d> result(p1.Order() + p2.Order());
+        for (monIndex alpha = 0; alpha < (monIndex)p1.Coefficients.size(); ++alpha) {
+            const double c1 = p1.Coefficients[alpha];
+            if (c1 == 0.0)
+                continue;
+            for (monIndex beta = 0; beta < (monIndex)p2.Coefficients.size(); ++beta)
+                result.Coefficients[Poly<d>::Product(alpha, beta)] += c1 * p2.Coefficients[beta];
+        }
+        return result;
+    }
+
+    template<int d>
+    DensePolynomial<d>& DensePolynomial<d>::operator*=(const DensePolynomial<d>& p) {
+        Coefficients = std::move((*this * p).Coefficients);
+        return *this;
+    }
+
+    /*
+        Part of p1 * p2 up to order K, of order min(K, p1.Order() + p2.Order()).
+        Monomials of p1 are taken by order, each of order k1 multiplying only the first SpaceDim(K - k1) coefficients of p2.
+    */
+    template<int d>
+    DensePolynomial<d> MultiplyTruncated(const DensePolynomial<d>& p1, const DensePolynomial<d>& p2, const monOrder K) {
+        if (p1.Coefficients.empty() || p2.Coefficients.empty() || K < 0)
+            return DensePolynomial<d>();
+        const monOrder k1Max = std::min(p1.Order(), K);
+        DensePolynomial<d> result(std::min(K, p1.Order() + p2.Order()));
+        for (monOrder k1 = 0; k1 <= k1Max; ++k1) {
+            const monIndex bound = std::min((monIndex)p2.Coefficients.size(), Poly<d>::SpaceDim(K - k1));
+            for (monIndex alpha = Poly<d>::SpaceDim(k1 - 1); alpha < Poly<d>::SpaceDim(k1); ++alpha) {
+                const double c1 = p1.Coefficients[alpha];
+                if (c1 == 0.0)
+                    continue;
+                for (monIndex beta = 0; beta < bound; ++beta)
+                    result.Coefficients[Poly<d>::Product(alpha, beta)] += c1 * p2.Coefficients[beta];
+            }
+        }
+        return result;
+    }
+
+    /*
+        Product looking up the indices in a ProductTable instead of recursing through Poly<d>::Product.
+    */
+    template<int d, monOrder K>
+    DensePolynomial<d> Multiply(const DensePolynomial<d>& p1, const DensePolynomial<d>& p2, const ProductTable<d, K>& table) {
+        if (p1.Coefficients.empty() || p2.Coefficients.empty())
+            return DensePolynomial<d>();
+        DensePolynomial<d> result(p1.Order() + p2.Order());
+        for (monIndex alpha = 0; alpha < (monIndex)p1.Coefficients.size(); ++alpha) {
+            const double c1 = p1.Coefficients[alpha];
+            if (c1 == 0.0)
+                continue;
+            for (monIndex beta = 0; beta < (monIndex)p2.Coefficients.size(); ++beta)
+                result.Coefficients[table.Product(alpha, beta)] += c1 * p2.Coefficients[beta];
+        }
+        return result;
+    }
+
+    /************************************************************
+        Products m_Left[i] * m_Right[i] = m_Target[i] of all pairs of
+        monomials of P_LeftOrder x P_RightOrder with product up to
+        order K, sorted by Target, so that products of polynomials
+        of these orders sweep their result in order.
+    ************************************************************/
+    template<int d>
+    struct ProductSchedule {
+        monOrder LeftOrder, RightOrder, TargetOrder;
+        std::vector<monIndex> Left, Right, Target;
+
+        ProductSchedule(const monOrder leftOrder, const monOrder rightOrder) : ProductSchedule(leftOrder, rightOrder, leftOrder + rightOrder) {}
+        ProductSchedule(const monOrder leftOrder, const monOrder rightOrder, const monOrder K)
+            : LeftOrder(leftOrder), RightOrder(rightOrder), TargetOrder(std::min(K, leftOrder + rightOrder)) {
+            std::vector<std::array<monIndex, 3>> triples;
+            for (monOrder k1 = 0; k1 <= std::min(leftOrder, K); ++k1) {
+                const monIndex bound = std::min(Poly<d>::SpaceDim(rightOrder), Poly<d>::SpaceDim(K - k1));
+                for (monIndex alpha = Poly<d>::SpaceDim(k1 - 1); alpha < Poly<d>::SpaceDim(k1); ++alpha)
+                    for (monIndex beta = 0; beta < bound; ++beta)
+                        triples.push_back({ Poly<d>::Product(alpha, beta), alpha, beta });
+            }
+            std::sort(triples.begin(), triples.end());
+            Left.reserve(triples.size());
+            Right.reserve(triples.size());
+            Target.reserve(triples.size());
+            for (const std::array<monIndex, 3>& triple : triples) {
+                Target.push_back(triple[0]);
+                Left.push_back(triple[1]);
+                Right.push_back(triple[2]);
+            }
+        }
+        size_t Size() const { return Target.size(); }
+    };
+
+    /************************************************************
+        Count dense polynomials of order Order, stored as structure
+        of arrays: Coefficients[alpha * Count + e] is the coefficient
+        of m_alpha in polynomial e, so the operations on all of them
+        run over contiguous rows and vectorize across polynomials.
+    ************************************************************/
+    template<int d>
+    struct DensePolynomialBatch {
+        monOrder Order = -1;
+        size_t Count = 0;
+        std::vector<double> Coefficients;
+
+        DensePolynomialBatch() = default;
+        DensePolynomialBatch(const monOrder k, const size_t count) { Resize(k, count); }
+
+        /*
+            Resets all coefficients to zero, reusing the storage.
+        */
+        void Resize(const monOrder k, const size_t count) {
+            Order = k;
+            Count = count;
+            Coefficients.assign((size_t)Poly<d>::SpaceDim(k) * count, 0.0);
+        }
+        double* Row(const monIndex alpha) { return Coefficients.data() + (size_t)alpha * Count; }
+        const double* Row(const monIndex alpha) const { return Coefficients.data() + (size_t)alpha * Count; }
+
+        DensePolynomial<d> Get(const size_t e) const {
+            DensePolynomial<d> p(Order);
+            for (size_t alpha = 0; alpha < p.Coefficients.size(); ++alpha)
+                p.Coefficients[alpha] = Coefficients[alpha * Count + e];
+            return p;
+        }
+        /*
+            Coefficients of p beyond Order are ignored, and those it does not have are set to zero.
+        */
+        void Set(const size_t e, const DensePolynomial<d>& p) {
+            const size_t size = (size_t)Poly<d>::SpaceDim(Order);
+            for (size_t alpha = 0; alpha < size; ++alpha)
+                Coefficients[alpha * Count + e] = (alpha < p.Coefficients.size() ? p.Coefficients[alpha] : 0.0);
+        }
+    };
+
+    /*
+        out[e] = p1[e] * p2[e] for all polynomials e of the batches, which must have the orders of the schedule and the same Count
+        (checked by assert). out must be neither p1 nor p2, its storage is reused.
+        Each triple of the schedule is a multiply-add of rows, vectorized across polynomials.
+        There is no operator* for batches: the schedule is meant to be built once and reused for all products of these orders.
+    */
+    template<int d>
+    void MultiplyInto(DensePolynomialBatch<d>& out, const DensePolynomialBatch<d>& p1, const DensePolynomialBatch<d>& p2, const ProductSchedule<d>& schedule) {
+        assert(p1.Order == schedule.LeftOrder && p2.Order == schedule.RightOrder);
+        assert(p1.Count == p2.Count);
+        assert(&out != &p1 && &out != &p2);
+        out.Resize(schedule.TargetOrder, p1.Count);
+        const size_t n = p1.Count;
+        for (size_t i = 0; i < schedule.Size(); ++i)
+            _VecFma(out.Row(schedule.Target[i]), p1.Row(schedule.Left[i]), p2.Row(schedule.Right[i]), n);
+    }
+
+#define ALIASdnl(d) using dnl ##d ##D = DensePolynomial<d>
+    ALIASdnl(1);
+    ALIASdnl(2);
+    ALIASdnl(3);
+    ALIASdnl(4);
+    ALIASdnl(5);
+    ALIASdnl(6);
+    ALIASdnl(7);
+    ALIASdnl(8);
+    ALIASdnl(9);
+#undef ALIASdnl
+
+}
+#endif
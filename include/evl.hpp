@@ -0,0 +1,420 @@
+/**********************************************************************************************************************************
+                                            Monomial's Library by Tiago Fernandes Moherdaui
+
+            The library is meant to make operations with monomials easier by use of indicial notation.
+
+            This file provides the evaluation of all monomials of P_k(R^d) at given points, ordered by their indices.
+
+                Values of m_0, ..., m_(SpaceDim(k) - 1) at x    mnl::EvaluateBasis<d>(x, k, out);
+                Values of all monomials at many points          mnl::EvaluateBasisBatch<d>(points, nPoints, k, out);
+                Values, gradients (and Hessians) at x           mnl::EvaluateBasisDerivatives<d>(x, k, values, gradients, hessians);
+
+            For the Virtual Element Method, scaled monomials ((x - x_E) / h_E)^alpha of an element E are provided by
+            mnl::ScaledMonomialBasis<d> basis(centroid, diameter, k), with batched evaluation of values and derivatives.
+
+            Monomials are never evaluated with pow, each of them is the product of a monomial of lower order (its parent)
+            by one of the variables, so each value costs a single multiplication.
+            For the monomials of order n, in sequence:
+                - The ones with exponent of x_0 >= 1 are x_0 times all monomials of order n - 1;
+                - The ones with exponent of x_0 = 0 and of x_1 >= 1 are x_1 times the monomials of order n - 1 without x_0;
+                - And so on, the monomials of order n - 1 without x_0, ..., x_(i-1) being the last ones of their order.
+
+            The batched version takes the points as structure of arrays, points[i * nPoints + p] being x_i of point p,
+            and writes a column-major SpaceDim(k) x nPoints matrix, out[p * SpaceDim(k) + alpha] being m_alpha at point p.
+            It runs the recursion over blocks of points at once, so the multiplications are vectorized across points.
+
+            Derivatives follow from the product rule on the same recursion, m_alpha = x_i m_parent:
+                d/dx_j(m_alpha) = delta_ij m_parent + x_i d/dx_j(m_parent),
+            so they reuse the values of the parents and cost one multiply-add each, with no decoding of exponents.
+
+            Polynomials are compiled for repeated evaluation by mnl::CompiledPolynomial<d> compiled(p.Terms), which computes
+            only the monomials of p and their parents, then accumulates the terms, for single points or batches of points:
+
+                Value at x                                      compiled(x);
+                Values at many points                           compiled.Evaluate(points, nPoints, out);
+
+            This is produced in C++17 and includes only <algorithm>, <array>, <utility> and <vector>.
+
+**********************************************************************************************************************************/
+#pragma once
+#ifndef EVL
+#define EVL
+#include "mnl.hpp"
+#include "smd.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace mnl {
+    /*
+        Number of monomials of order exactly k in d variables.
+    */
+    constexpr monIndex _OrderDim(const int d, const monOrder k) {
+        return (k < 0 ? 0 : (monIndex)Binomial(k + d - 1, d - 1));
+    }
+
+    /************************************************************
+        Values of all monomials of P_k(R^d) at point x (x[0], ..., x[d-1]),
+        written to out[0], ..., out[SpaceDim(k) - 1].
+        No allocations, one multiplication per monomial.
+    ************************************************************/
+    template<const int d>
+    void EvaluateBasis(const double* x, const monOrder k, double* out) {
+        out[0] = 1.0;
+        for (monOrder n = 1; n <= k; ++n) {
+            const monIndex previousEnd = Poly<d>::SpaceDim(n - 1);
+            monIndex dst = previousEnd;
+            for (int i = 0; i < d; ++i) {
+                // Monomials of order n - 1 in x_i, ..., x_(d-1), at the end of the previous order.
+                const monIndex count = _OrderDim(d - i, n - 1);
+                const double* parents = out + previousEnd - count;
+                const double xi = x[i];
+                for (monIndex j = 0; j < count; ++j)
+                    out[dst + j] = parents[j] * xi;
+                dst += count;
+            }
+        }
+    }
+
+    /************************************************************
+        Component of the second derivative d2/dx_j dx_l, j <= l, in
+        the upper triangle of the Hessian stored row by row.
+    ************************************************************/
+    template<const int d>
+    constexpr int HessianComponent(const int j, const int l) {
+        return j * d - (j * (j - 1)) / 2 + (l - j);
+    }
+
+    /************************************************************
+        Values, gradients and optionally Hessians of all monomials of
+        P_k(R^d) at point x, computed in a single sweep, with
+        N = SpaceDim(k):
+            values[alpha]                           m_alpha
+            gradients[j * N + alpha]                d/dx_j(m_alpha)
+            hessians[HessianComponent<d>(j, l) * N + alpha]
+                                                    d2/dx_j dx_l(m_alpha)
+        hessians holds d(d+1)/2 components and can be nullptr.
+    ************************************************************/
+    template<const int d>
+    void EvaluateBasisDerivatives(const double* x, const monOrder k, double* values, double* gradients, double* hessians = nullptr) {
+        const size_t nMonomials = (size_t)Poly<d>::SpaceDim(k);
+        values[0] = 1.0;
+        for (int j = 0; j < d; ++j)
+            gradients[j * nMonomials] = 0.0;
+        if (hessians)
+            for (int c = 0; c < (d * (d + 1)) / 2; ++c)
+                hessians[c * nMonomials] = 0.0;
+
+        for (monOrder n = 1; n <= k; ++n) {
+            const monIndex previousEnd = Poly<d>::SpaceDim(n - 1);
+            monIndex dst = previousEnd;
+            for (int i = 0; i < d; ++i) {
+                const monIndex count = _OrderDim(d - i, n - 1);
+                const monIndex parents = previousEnd - count;
+                const double xi = x[i];
+                if (hessians) {
+                    for (int j = 0; j < d; ++j) {
+                        for (int l = j; l < d; ++l) {
+                            double* h = hessians + HessianComponent<d>(j, l) * nMonomials;
+                            for (monIndex t = 0; t < count; ++t)
+                                h[dst + t] = xi * h[parents + t];
+                            if (i == j)
+                                for (monIndex t = 0; t < count; ++t)
+                                    h[dst + t] += gradients[l * nMonomials + parents + t];
+                            if (i == l)
+                                for (monIndex t = 0; t < count; ++t)
+                                    h[dst + t] += gradients[j * nMonomials + parents + t];
+                        }
+                    }
+                }
+                for (int j = 0; j < d; ++j) {
+                    double* g = gradients + j * nMonomials;
+                    if (i == j)
+                        for (monIndex t = 0; t < count; ++t)
+                            g[dst + t] = xi * g[parents + t] + values[parents + t];
+                    else
+                        for (monIndex t = 0; t < count; ++t)
+                            g[dst + t] = xi * g[parents + t];
+                }
+                for (monIndex t = 0; t < count; ++t)
+                    values[dst + t] = xi * values[parents + t];
+                dst += count;
+            }
+        }
+    }
+
+    /*
+        Number of points evaluated at once by EvaluateBasisBatch, a multiple of _simdWidth so that the kernels on a block
+        only use full vectors.
+    */
+    constexpr int _basisBlock = 8;
+    static_assert(_basisBlock % _simdWidth == 0, "A block of points is made of full vectors.");
+
+    /************************************************************
+        Size of the workspace used by EvaluateBasisBatch.
+    ************************************************************/
+    template<const int d>
+    size_t BasisBatchWorkspaceSize(const monOrder k) {
+        return (size_t)(d + Poly<d>::SpaceDim(k)) * _basisBlock;
+    }
+
+    /************************************************************
+        Values of all monomials of P_k(R^d) at nPoints points given
+        as points[i * nPoints + p] = x_i of point p, written as
+        out[p * SpaceDim(k) + alpha] = m_alpha at point p.
+        A workspace of BasisBatchWorkspaceSize<d>(k) doubles can be
+        provided to avoid allocating one.
+    ************************************************************/
+    template<const int d>
+    void EvaluateBasisBatch(const double* points, const size_t nPoints, const monOrder k, double* out, double* workspace = nullptr) {
+        const monIndex nMonomials = Poly<d>::SpaceDim(k);
+        std::vector<double> ownWorkspace;
+        if (!workspace) {
+            ownWorkspace.resize(BasisBatchWorkspaceSize<d>(k));
+            workspace = ownWorkspace.data();
+        }
+        // Coordinates of the block, xs[i * _basisBlock + lane], followed by the values, tile[alpha * _basisBlock + lane].
+        double* xs = workspace;
+        double* tile = workspace + d * _basisBlock;
+
+        for (size_t p0 = 0; p0 < nPoints; p0 += _basisBlock) {
+            const size_t nLanes = (nPoints - p0 < (size_t)_basisBlock ? nPoints - p0 : (size_t)_basisBlock);
+            for (int i = 0; i < d; ++i)
+                for (size_t lane = 0; lane < (size_t)_basisBlock; ++lane)
+                    xs[i * _basisBlock + lane] = (lane < nLanes ? points[i * nPoints + p0 + lane] : 0.0);
+
+            for (size_t lane = 0; lane < (size_t)_basisBlock; ++lane)
+                tile[lane] = 1.0;
+            for (monOrder n = 1; n <= k; ++n) {
+                const monIndex previousEnd = Poly<d>::SpaceDim(n - 1);
+                monIndex dst = previousEnd;
+                for (int i = 0; i < d; ++i) {
+                    const monIndex count = _OrderDim(d - i, n - 1);
+                    const monIndex parents = previousEnd - count;
+                    for (monIndex j = 0; j < count; ++j)
+                        _VecMul(tile + (size_t)(dst + j) * _basisBlock, tile + (size_t)(parents + j) * _basisBlock, xs + i * _basisBlock, _basisBlock);
+                    dst += count;
+                }
+            }
+
+            for (size_t lane = 0; lane < nLanes; ++lane) {
+                double* column = out + (p0 + lane) * (size_t)nMonomials;
+                for (monIndex alpha = 0; alpha < nMonomials; ++alpha)
+                    column[alpha] = tile[(size_t)alpha * _basisBlock + lane];
+            }
+        }
+    }
+
+    /************************************************************
+        Scaled monomials of order up to k of an element E,
+        m_alpha((x - x_E) / h_E), with centroid x_E and diameter h_E.
+        Points are given in global coordinates, as structure of
+        arrays (points[i * nPoints + p]), derivatives are taken with
+        respect to the global coordinates.
+        Buffers are kept between calls, so evaluations do not
+        allocate once they have seen the largest number of points.
+    ************************************************************/
+    template<const int d>
+    class ScaledMonomialBasis {
+    public:
+        ScaledMonomialBasis(const std::array<double, d>& centroid, const double diameter, const monOrder k)
+            : _centroid(centroid), _diameter(diameter), _order(k), _size(Poly<d>::SpaceDim(k)),
+            // Each derivative of a scaled monomial brings a factor 1 / h_E.
+            _derivativeScale{ 1.0, 1.0 / diameter, 1.0 / diameter / diameter } {}
+
+        const std::array<double, d>&    Centroid() const { return _centroid; }
+        double                          Diameter() const { return _diameter; }
+        monOrder                        Order() const { return _order; }
+        monIndex                        Size() const { return _size; }
+        // Factor 1 / h_E^r of the derivatives of order r, r <= 2.
+        double                          DerivativeScale(const int r) const { return _derivativeScale[r]; }
+
+        /************************************************************
+            Values, out[p * Size() + alpha].
+        ************************************************************/
+        void Values(const double* points, const size_t nPoints, double* out) {
+            _ToLocal(points, nPoints);
+            _workspace.resize(BasisBatchWorkspaceSize<d>(_order));
+            EvaluateBasisBatch<d>(_local.data(), nPoints, _order, out, _workspace.data());
+        }
+
+        /************************************************************
+            Values, out[p * Size() + alpha], gradients,
+            gradients[(p * d + j) * Size() + alpha], and optionally
+            Hessians, hessians[(p * d(d+1)/2 + c) * Size() + alpha],
+            with c = HessianComponent<d>(j, l).
+        ************************************************************/
+        void ValuesAndDerivatives(const double* points, const size_t nPoints, double* values, double* gradients, double* hessians = nullptr) {
+            constexpr int nHessian = (d * (d + 1)) / 2;
+            const size_t n = (size_t)_size;
+            _ToLocal(points, nPoints);
+            std::array<double, d> xi{};
+            for (size_t p = 0; p < nPoints; ++p) {
+                for (int i = 0; i < d; ++i)
+                    xi[i] = _local[i * nPoints + p];
+                double* g = gradients + p * d * n;
+                double* h = (hessians ? hessians + p * nHessian * n : nullptr);
+                EvaluateBasisDerivatives<d>(xi.data(), _order, values + p * n, g, h);
+                for (size_t t = 0; t < d * n; ++t)
+                    g[t] *= _derivativeScale[1];
+                if (h)
+                    for (size_t t = 0; t < nHessian * n; ++t)
+                        h[t] *= _derivativeScale[2];
+            }
+        }
+
+    private:
+        std::array<double, d>   _centroid;
+        double                  _diameter;
+        monOrder                _order;
+        monIndex                _size;
+        std::array<double, 3>   _derivativeScale;
+        std::vector<double>     _local;
+        std::vector<double>     _workspace;
+
+        void _ToLocal(const double* points, const size_t nPoints) {
+            _local.resize(d * nPoints);
+            const double scale = _derivativeScale[1];
+            for (int i = 0; i < d; ++i)
+                for (size_t p = 0; p < nPoints; ++p)
+                    _local[i * nPoints + p] = (points[i * nPoints + p] - _centroid[i]) * scale;
+        }
+    };
+
+    /************************************************************
+        Polynomial compiled into an evaluation program sharing the
+        computation of its monomials: only the monomials of the
+        polynomial and their parents (down to 1) are computed, each
+        as its parent times one variable, the parent of m_alpha being
+        m_alpha divided by its first variable, as in EvaluateBasis.
+        The values are then accumulated with the coefficients.
+        Built from any range of (index, coefficient) pairs, e.g.,
+        the Terms of Polynomial<d> or FlatPolynomial<d>, or from
+        dense coefficients.
+    ************************************************************/
+    template<const int d>
+    class CompiledPolynomial {
+    public:
+        CompiledPolynomial() = default;
+        template<typename Terms>
+        explicit CompiledPolynomial(const Terms& terms) {
+            std::vector<std::pair<monIndex, double>> nonZero;
+            for (const auto& term : terms)
+                if (term.second != 0.0)
+                    nonZero.emplace_back(term.first, term.second);
+            _Compile(nonZero);
+        }
+        CompiledPolynomial(const double* coefficients, const monIndex nCoefficients) {
+            std::vector<std::pair<monIndex, double>> nonZero;
+            for (monIndex alpha = 0; alpha < nCoefficients; ++alpha)
+                if (coefficients[alpha] != 0.0)
+                    nonZero.emplace_back(alpha, coefficients[alpha]);
+            _Compile(nonZero);
+        }
+
+        /*
+            Number of monomials computed in each evaluation.
+        */
+        size_t Size() const { return _monomials.size(); }
+        size_t WorkspaceSize() const { return (d + std::max<size_t>(_monomials.size(), 1)) * _basisBlock; }
+
+        /************************************************************
+            Values at nPoints points given as points[i * nPoints + p]
+            = x_i of point p, written to out[p]. A workspace of
+            WorkspaceSize() doubles can be provided to avoid
+            allocating one.
+        ************************************************************/
+        void Evaluate(const double* points, const size_t nPoints, double* out, double* workspace = nullptr) const {
+            std::vector<double> ownWorkspace;
+            if (!workspace) {
+                ownWorkspace.resize(WorkspaceSize());
+                workspace = ownWorkspace.data();
+            }
+            // Coordinates of the block, xs[i * _basisBlock + lane], followed by the values, tile[slot * _basisBlock + lane].
+            double* xs = workspace;
+            double* tile = workspace + d * _basisBlock;
+            double sum[_basisBlock];
+
+            for (size_t p0 = 0; p0 < nPoints; p0 += _basisBlock) {
+                const size_t nLanes = (nPoints - p0 < (size_t)_basisBlock ? nPoints - p0 : (size_t)_basisBlock);
+                for (int i = 0; i < d; ++i)
+                    for (size_t lane = 0; lane < (size_t)_basisBlock; ++lane)
+                        xs[i * _basisBlock + lane] = (lane < nLanes ? points[i * nPoints + p0 + lane] : 0.0);
+
+                for (size_t lane = 0; lane < (size_t)_basisBlock; ++lane) {
+                    tile[lane] = 1.0;
+                    sum[lane] = 0.0;
+                }
+                for (size_t slot = 1; slot < _monomials.size(); ++slot)
+                    _VecMul(tile + slot * _basisBlock, tile + (size_t)_parents[slot] * _basisBlock, xs + _variables[slot] * _basisBlock, _basisBlock);
+                for (size_t t = 0; t < _coefficients.size(); ++t)
+                    _VecAxpy(sum, _coefficients[t], tile + (size_t)_termSlots[t] * _basisBlock, _basisBlock);
+
+                for (size_t lane = 0; lane < nLanes; ++lane)
+                    out[p0 + lane] = sum[lane];
+            }
+        }
+
+        /*
+            Value at a single point x.
+        */
+        double operator()(const double* x) const {
+            if (_monomials.empty())
+                return 0.0;
+            std::vector<double> values(_monomials.size());
+            values[0] = 1.0;
+            for (size_t slot = 1; slot < _monomials.size(); ++slot)
+                values[slot] = values[_parents[slot]] * x[_variables[slot]];
+            double sum = 0.0;
+            for (size_t t = 0; t < _coefficients.size(); ++t)
+                sum += _coefficients[t] * values[_termSlots[t]];
+            return sum;
+        }
+        double operator()(const std::array<double, d>& x) const { return (*this)(x.data()); }
+
+    private:
+        void _Compile(const std::vector<std::pair<monIndex, double>>& terms) {
+            if (terms.empty())
+                return;
+            // Monomials of the terms and all their ancestors, in index order, so parents come first.
+            _monomials.push_back(0);
+            for (const auto& term : terms)
+                for (monIndex alpha = term.first; alpha > 0; alpha = _Parent(alpha).first)
+                    _monomials.push_back(alpha);
+            std::sort(_monomials.begin(), _monomials.end());
+            _monomials.erase(std::unique(_monomials.begin(), _monomials.end()), _monomials.end());
+
+            _parents.assign(_monomials.size(), 0);
+            _variables.assign(_monomials.size(), 0);
+            for (size_t slot = 1; slot < _monomials.size(); ++slot) {
+                const std::pair<monIndex, int> parent = _Parent(_monomials[slot]);
+                _parents[slot] = _Slot(parent.first);
+                _variables[slot] = parent.second;
+            }
+            for (const auto& term : terms) {
+                _termSlots.push_back(_Slot(term.first));
+                _coefficients.push_back(term.second);
+            }
+        }
+
+        /*
+            Index of the parent of m_alpha and the variable dividing it.
+        */
+        static std::pair<monIndex, int> _Parent(const monIndex alpha) {
+            const std::array<int, d> e = Poly<d>::Exponents(alpha);
+            int i = 0;
+            while (e[i] == 0)
+                ++i;
+            return { Poly<d>::D(alpha, i), i };
+        }
+        size_t _Slot(const monIndex alpha) const {
+            return (size_t)(std::lower_bound(_monomials.begin(), _monomials.end(), alpha) - _monomials.begin());
+        }
+
+        std::vector<monIndex> _monomials;
+        std::vector<size_t> _parents, _termSlots;
+        std::vector<int> _variables;
+        std::vector<double> _coefficients;
+    };
+}
+#endif
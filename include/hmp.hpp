@@ -0,0 +1,248 @@
+/**********************************************************************************************************************************
+                                            Monomial's Library by Tiago Fernandes Moherdaui
+
+            The library is meant to make operations with monomials easier by use of indicial notation.
+
+            This file provides a hash map with integer keys stored in a single flat array of slots (open addressing),
+            meant as backend for the terms of polynomials, mnl::Polynomial<d, mnl::OpenHashMap<monIndex, double>>.
+
+                Map with an allocator                           mnl::OpenHashMap<Key, T, Allocator> map(allocator);
+                Access (inserting T() if absent)                map[key];
+                Lookup                                          map.find(key); map.count(key); map.at(key);
+                Removal                                         map.erase(key); it = map.erase(it);
+                Removal of all entries, keeping the slots       map.clear();
+                Exchange of contents                            map.swap(other);
+
+            It follows the interface of std::unordered_map for these operations and for the iteration over its entries,
+            which are std::pair<Key, T>, but keys must not be modified through iterators.
+            Slots are found by linear probing from the key modulo the number of slots, the array being kept at most 3/4 full.
+            Keys are not scrambled: monomial indices up to an order are consecutive, so they land in distinct slots and in the
+            order of the indices, which a scrambling hash would only spread over the array.
+            Erasing shifts the following entries of the probe sequence backwards instead of leaving tombstones, so erasing
+            does not degrade lookups. When erasing while iterating, it = map.erase(it) does not skip any entry, but entries
+            that wrapped around the end of the array may be visited again.
+            The largest value of Key is reserved to mark empty slots.
+
+            This is produced in C++17 and includes only <cstddef>, <iterator>, <limits>, <memory>, <stdexcept>, <type_traits>, <utility> and <vector>.
+
+**********************************************************************************************************************************/
+#pragma once
+#ifndef HMP
+#define HMP
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mnl {
+    template<typename Key, typename T, typename Allocator = std::allocator<std::pair<Key, T>>>
+    class OpenHashMap {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using size_type = size_t;
+        using allocator_type = Allocator;
+
+        template<bool isConst>
+        class Iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::pair<Key, T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<isConst, const value_type*, value_type*>;
+            using reference = std::conditional_t<isConst, const value_type&, value_type&>;
+
+            Iterator() = default;
+            Iterator(const Iterator&) = default;
+            Iterator& operator=(const Iterator&) = default;
+            // Conversion from iterator to const_iterator
+            template<bool wasConst, typename = std::enable_if_t<isConst && !wasConst>>
+            Iterator(const Iterator<wasConst>& it) : _slot(it._slot), _end(it._end) {}
+
+            reference operator*() const { return *_slot; }
+            pointer operator->() const { return _slot; }
+            Iterator& operator++() {
+                ++_slot;
+                _SkipEmpty();
+                return *this;
+            }
+            Iterator operator++(int) {
+                Iterator previous = *this;
+                ++(*this);
+                return previous;
+            }
+            bool operator==(const Iterator& other) const { return _slot == other._slot; }
+            bool operator!=(const Iterator& other) const { return _slot != other._slot; }
+
+        private:
+            friend class OpenHashMap;
+            template<bool> friend class Iterator;
+            Iterator(pointer slot, pointer end) : _slot(slot), _end(end) { _SkipEmpty(); }
+            void _SkipEmpty() {
+                while (_slot != _end && _slot->first == _emptyKey)
+                    ++_slot;
+            }
+
+            pointer _slot = nullptr;
+            pointer _end = nullptr;
+        };
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        OpenHashMap() = default;
+        explicit OpenHashMap(const Allocator& allocator) : _slots(allocator) {}
+
+        iterator begin() { return iterator(_slots.data(), _slots.data() + _slots.size()); }
+        iterator end() { return iterator(_slots.data() + _slots.size(), _slots.data() + _slots.size()); }
+        const_iterator begin() const { return const_iterator(_slots.data(), _slots.data() + _slots.size()); }
+        const_iterator end() const { return const_iterator(_slots.data() + _slots.size(), _slots.data() + _slots.size()); }
+
+        size_type size() const { return _size; }
+        bool empty() const { return _size == 0; }
+        size_type bucket_count() const { return _slots.size(); }
+        allocator_type get_allocator() const { return _slots.get_allocator(); }
+
+        /************************************************************
+            Empties all slots, keeping their storage.
+        ************************************************************/
+        void clear() {
+            for (value_type& slot : _slots)
+                slot = value_type(_emptyKey, T());
+            _size = 0;
+        }
+
+        void swap(OpenHashMap& other) {
+            _slots.swap(other._slots);
+            std::swap(_size, other._size);
+            std::swap(_mask, other._mask);
+        }
+
+        /************************************************************
+            Makes room for n entries without rehashing.
+        ************************************************************/
+        void reserve(const size_type n) {
+            size_type capacity = 8;
+            while (4 * n > 3 * capacity)
+                capacity *= 2;
+            if (capacity > _slots.size())
+                _Rehash(capacity);
+        }
+
+        T& operator[](const Key key) {
+            if (4 * (_size + 1) > 3 * _slots.size())
+                _Rehash(_slots.empty() ? 8 : 2 * _slots.size());
+            size_type i = _Home(key);
+            while (_slots[i].first != _emptyKey) {
+                if (_slots[i].first == key)
+                    return _slots[i].second;
+                i = (i + 1) & _mask;
+            }
+            _slots[i] = value_type(key, T());
+            ++_size;
+            return _slots[i].second;
+        }
+
+        iterator find(const Key key) {
+            const size_type i = _Find(key);
+            return (i == _npos ? end() : iterator(_slots.data() + i, _slots.data() + _slots.size()));
+        }
+        const_iterator find(const Key key) const {
+            const size_type i = _Find(key);
+            return (i == _npos ? end() : const_iterator(_slots.data() + i, _slots.data() + _slots.size()));
+        }
+        size_type count(const Key key) const { return (_Find(key) == _npos ? 0 : 1); }
+        T& at(const Key key) {
+            const size_type i = _Find(key);
+            if (i == _npos)
+                throw std::out_of_range("mnl::OpenHashMap::at");
+            return _slots[i].second;
+        }
+        const T& at(const Key key) const {
+            const size_type i = _Find(key);
+            if (i == _npos)
+                throw std::out_of_range("mnl::OpenHashMap::at");
+            return _slots[i].second;
+        }
+
+        /************************************************************
+            Removes the entry at it, returning the iterator to the
+            entry now in its slot, or to the next one.
+        ************************************************************/
+        iterator erase(const_iterator it) {
+            const size_type i = (size_type)(it._slot - _slots.data());
+            _EraseSlot(i);
+            return iterator(_slots.data() + i, _slots.data() + _slots.size());
+        }
+        size_type erase(const Key key) {
+            const size_type i = _Find(key);
+            if (i == _npos)
+                return 0;
+            _EraseSlot(i);
+            return 1;
+        }
+
+    private:
+        static constexpr Key _emptyKey = std::numeric_limits<Key>::max();
+        static constexpr size_type _npos = std::numeric_limits<size_type>::max();
+
+        size_type _Home(const Key key) const {
+            return (size_type)key & _mask;
+        }
+
+        size_type _Find(const Key key) const {
+            if (_size == 0)
+                return _npos;
+            size_type i = _Home(key);
+            while (_slots[i].first != _emptyKey) {
+                if (_slots[i].first == key)
+                    return i;
+                i = (i + 1) & _mask;
+            }
+            return _npos;
+        }
+
+        /*
+            Backward-shift deletion: entries after the hole whose home is not cyclically in (hole, position] are moved into it.
+        */
+        void _EraseSlot(size_type hole) {
+            size_type j = hole;
+            while (true) {
+                j = (j + 1) & _mask;
+                if (_slots[j].first == _emptyKey)
+                    break;
+                const size_type home = _Home(_slots[j].first);
+                const bool stays = (hole <= j ? (hole < home && home <= j) : (hole < home || home <= j));
+                if (!stays) {
+                    _slots[hole] = std::move(_slots[j]);
+                    hole = j;
+                }
+            }
+            _slots[hole] = value_type(_emptyKey, T());
+            --_size;
+        }
+
+        void _Rehash(const size_type capacity) {
+            std::vector<value_type, Allocator> previous(capacity, value_type(_emptyKey, T()), _slots.get_allocator());
+            previous.swap(_slots);
+            _mask = capacity - 1;
+            for (value_type& slot : previous) {
+                if (slot.first == _emptyKey)
+                    continue;
+                size_type i = _Home(slot.first);
+                while (_slots[i].first != _emptyKey)
+                    i = (i + 1) & _mask;
+                _slots[i] = std::move(slot);
+            }
+        }
+
+        std::vector<value_type, Allocator> _slots;
+        size_type _size = 0;
+        size_type _mask = 0;
+    };
+}
+#endif
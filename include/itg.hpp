@@ -0,0 +1,259 @@
+/**********************************************************************************************************************************
+                                            Monomial's Library by Tiago Fernandes Moherdaui
+
+            The library is meant to make operations with monomials easier by use of indicial notation.
+
+            This file provides integrals of all monomials of P_k(R^d), ordered by their indices, without quadrature.
+
+                Moments over the reference simplex              mnl::ReferenceMoments<d>::Simplex(k);
+                Moments over the unit hypercube [0,1]^d         mnl::ReferenceMoments<d>::Cube(k);
+
+            Moments over the reference simplex {x_i >= 0, x_0 + ... + x_(d-1) <= 1} are normalized by its volume 1/d!,
+            as the weights of the quadratures in gtq.hpp, i.e., the moment of m_alpha is alpha_0!...alpha_(d-1)! d! / (|alpha| + d)!.
+            Moments up to a fixed order K can be computed at compile time, e.g., constexpr auto m = ReferenceMoments<d>::Simplex<K>();
+
+                Integrals over a polygon                        mnl::IntegratePolygonMonomials(vertices, k);
+                Integrals over a polyhedron                     mnl::IntegratePolyhedronMonomials(vertices, faces, k);
+
+            Integrals over polytopes use Homogeneous Numerical Integration: for m_alpha, homogeneous of order q = |alpha|,
+            Euler's theorem and the divergence theorem over a polytope P of dimension n give
+                (n + q) int_P m_alpha = sum_F b_F int_F m_alpha,        b_F = n_F . x_F,
+            for the facets F of P, with outward unit normals n_F and any point x_F in F.
+            On a segment [v1, v2] of length L, taking v1 as origin, the same argument gives
+                (1 + q) int_e m_alpha = L m_alpha(v2) + sum_i v1_i e_i int_e m_D(alpha, i),
+            so the integrals of a whole edge follow from the values at v2 and from the integrals of lower order on the
+            same edge, each edge being swept once for all monomials, without quadrature.
+            Faces of polyhedra are reduced to their edges in the same way, taking their first vertex x_0 as origin:
+                (2 + q) int_F m_alpha = sum_e d_e int_e m_alpha + sum_i x_0i e_i int_F m_D(alpha, i),
+            with d_e = m_e . (x_e - x_0) for the outward normals m_e of the edges in the plane of F.
+            As usual for HNI, accuracy is best when the polytope is close to the origin, e.g., in scaled coordinates.
+
+            This is produced in C++17 and includes only <algorithm>, <array>, <cmath>, <map> and <vector>.
+
+**********************************************************************************************************************************/
+#pragma once
+#ifndef ITG
+#define ITG
+#include "mnl.hpp"
+#include "evl.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+namespace mnl {
+    template<const int d>
+    struct ReferenceMoments {
+        /************************************************************
+            Moment of the monomial with exponents e over the reference
+            simplex, normalized by its volume:
+                e! d! / (|e| + d)! = 1 / prod_i C(s_i + e_i, e_i),
+            with s_0 = d and s_(i+1) = s_i + e_i.
+        ************************************************************/
+        constexpr static double SimplexMoment(const std::array<int, d>& e) {
+            double denominator = 1.0;
+            int s = d;
+            for (int i = 0; i < d; ++i) {
+                denominator *= (double)Binomial(s + e[i], e[i]);
+                s += e[i];
+            }
+            return 1.0 / denominator;
+        }
+
+        /************************************************************
+            Integral of the monomial with exponents e over [0,1]^d.
+        ************************************************************/
+        constexpr static double CubeMoment(const std::array<int, d>& e) {
+            double moment = 1.0;
+            for (int i = 0; i < d; ++i)
+                moment /= (double)(e[i] + 1);
+            return moment;
+        }
+
+        /************************************************************
+            Moments of m_0, ..., m_(SpaceDim(k) - 1).
+        ************************************************************/
+        static std::vector<double> Simplex(const monOrder k) {
+            std::vector<double> moments((size_t)Poly<d>::SpaceDim(k));
+            for (const MonomialEntry<d>& m : Monomials<d>(k))
+                moments[m.Index] = SimplexMoment(m.Exponents);
+            return moments;
+        }
+        static std::vector<double> Cube(const monOrder k) {
+            std::vector<double> moments((size_t)Poly<d>::SpaceDim(k));
+            for (const MonomialEntry<d>& m : Monomials<d>(k))
+                moments[m.Index] = CubeMoment(m.Exponents);
+            return moments;
+        }
+
+        /************************************************************
+            Moments up to order K, computed at compile time.
+        ************************************************************/
+        template<const monOrder K>
+        constexpr static std::array<double, Poly<d>::SpaceDim(K)> Simplex() {
+            std::array<double, Poly<d>::SpaceDim(K)> moments{};
+            for (const MonomialEntry<d>& m : Monomials<d>(K))
+                moments[m.Index] = SimplexMoment(m.Exponents);
+            return moments;
+        }
+        template<const monOrder K>
+        constexpr static std::array<double, Poly<d>::SpaceDim(K)> Cube() {
+            std::array<double, Poly<d>::SpaceDim(K)> moments{};
+            for (const MonomialEntry<d>& m : Monomials<d>(K))
+                moments[m.Index] = CubeMoment(m.Exponents);
+            return moments;
+        }
+    };
+
+    /************************************************************
+        Derivatives of all monomials of P_k(R^d), as used by the
+        HNI recursions:
+            d/dx_i(m_alpha) = Coefficients[alpha * d + i] m_Targets[alpha * d + i],
+        with Targets = -1 when the coefficient is zero.
+    ************************************************************/
+    template<const int d>
+    struct _MonomialDerivatives {
+        std::vector<monOrder> Orders;
+        std::vector<monIndex> Targets;
+        std::vector<double> Coefficients;
+
+        explicit _MonomialDerivatives(const monOrder k) {
+            const size_t size = (size_t)Poly<d>::SpaceDim(k);
+            Orders.resize(size);
+            Targets.resize(size * d);
+            Coefficients.resize(size * d);
+            for (const MonomialEntry<d>& m : Monomials<d>(k)) {
+                Orders[m.Index] = m.Order;
+                for (int i = 0; i < d; ++i) {
+                    Targets[(size_t)m.Index * d + i] = (m.Exponents[i] == 0 ? -1 : Poly<d>::D(m.Index, i));
+                    Coefficients[(size_t)m.Index * d + i] = (double)m.Exponents[i];
+                }
+            }
+        }
+    };
+
+    /************************************************************
+        Integrals of all monomials up to order k over the segment
+        [v1, v2], using values as workspace for SpaceDim(k) doubles.
+    ************************************************************/
+    template<const int d>
+    inline void _IntegrateEdgeMonomials(const double* v1, const double* v2, const _MonomialDerivatives<d>& derivatives, double* values, double* out) {
+        const size_t size = derivatives.Orders.size();
+        double length = 0.0;
+        for (int i = 0; i < d; ++i)
+            length += (v2[i] - v1[i]) * (v2[i] - v1[i]);
+        length = std::sqrt(length);
+        EvaluateBasis<d>(v2, derivatives.Orders[size - 1], values);
+        for (size_t alpha = 0; alpha < size; ++alpha) {
+            double sum = length * values[alpha];
+            for (int i = 0; i < d; ++i) {
+                const monIndex target = derivatives.Targets[alpha * d + i];
+                if (target >= 0)
+                    sum += v1[i] * derivatives.Coefficients[alpha * d + i] * out[target];
+            }
+            out[alpha] = sum / (double)(derivatives.Orders[alpha] + 1);
+        }
+    }
+
+    /************************************************************
+        Integrals of m_0, ..., m_(SpaceDim(k) - 1) over the polygon
+        with the given vertices, in counterclockwise order.
+    ************************************************************/
+    inline std::vector<double> IntegratePolygonMonomials(const std::vector<std::array<double, 2>>& vertices, const monOrder k) {
+        const _MonomialDerivatives<2> derivatives(k);
+        const size_t size = derivatives.Orders.size();
+        std::vector<double> integrals(size, 0.0), edge(size), values(size);
+        const size_t nVertices = vertices.size();
+        for (size_t v = 0; v < nVertices; ++v) {
+            const std::array<double, 2>& v1 = vertices[v];
+            const std::array<double, 2>& v2 = vertices[(v + 1) % nVertices];
+            const double dx = v2[0] - v1[0], dy = v2[1] - v1[1];
+            const double length = std::sqrt(dx * dx + dy * dy);
+            if (length == 0.0)
+                continue;
+            // outward normal of a counterclockwise polygon: (dy, -dx) / length
+            const double b = (dy * v1[0] - dx * v1[1]) / length;
+            if (b == 0.0)
+                continue;
+            _IntegrateEdgeMonomials<2>(v1.data(), v2.data(), derivatives, values.data(), edge.data());
+            for (size_t alpha = 0; alpha < size; ++alpha)
+                integrals[alpha] += b * edge[alpha];
+        }
+        for (size_t alpha = 0; alpha < size; ++alpha)
+            integrals[alpha] /= (double)(2 + derivatives.Orders[alpha]);
+        return integrals;
+    }
+
+    /************************************************************
+        Integrals of m_0, ..., m_(SpaceDim(k) - 1) over the
+        polyhedron with the given vertices and faces, each face
+        being a loop of vertex indices, counterclockwise when seen
+        from outside. Integrals over edges shared by faces are
+        computed once.
+    ************************************************************/
+    inline std::vector<double> IntegratePolyhedronMonomials(const std::vector<std::array<double, 3>>& vertices, const std::vector<std::vector<int>>& faces, const monOrder k) {
+        const _MonomialDerivatives<3> derivatives(k);
+        const size_t size = derivatives.Orders.size();
+        std::vector<double> integrals(size, 0.0), face(size), values(size);
+        std::map<std::pair<int, int>, std::vector<double>> edges;
+        for (const std::vector<int>& loop : faces) {
+            const size_t nVertices = loop.size();
+            // Newell's normal
+            std::array<double, 3> n{ 0.0, 0.0, 0.0 };
+            for (size_t v = 0; v < nVertices; ++v) {
+                const std::array<double, 3>& a = vertices[loop[v]];
+                const std::array<double, 3>& b = vertices[loop[(v + 1) % nVertices]];
+                n[0] += (a[1] - b[1]) * (a[2] + b[2]);
+                n[1] += (a[2] - b[2]) * (a[0] + b[0]);
+                n[2] += (a[0] - b[0]) * (a[1] + b[1]);
+            }
+            const double norm = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (norm == 0.0)
+                continue;
+            for (int i = 0; i < 3; ++i)
+                n[i] /= norm;
+            const std::array<double, 3>& x0 = vertices[loop[0]];
+            const double b = n[0] * x0[0] + n[1] * x0[1] + n[2] * x0[2];
+            if (b == 0.0)
+                continue;
+
+            std::fill(face.begin(), face.end(), 0.0);
+            // Edges through x0 have d_e = 0
+            for (size_t v = 1; v + 1 < nVertices; ++v) {
+                const std::array<double, 3>& v1 = vertices[loop[v]];
+                const std::array<double, 3>& v2 = vertices[loop[v + 1]];
+                const std::array<double, 3> t{ v2[0] - v1[0], v2[1] - v1[1], v2[2] - v1[2] };
+                const double length = std::sqrt(t[0] * t[0] + t[1] * t[1] + t[2] * t[2]);
+                if (length == 0.0)
+                    continue;
+                // m_e = t x n / |t|
+                const std::array<double, 3> m{ t[1] * n[2] - t[2] * n[1], t[2] * n[0] - t[0] * n[2], t[0] * n[1] - t[1] * n[0] };
+                const double de = (m[0] * (v1[0] - x0[0]) + m[1] * (v1[1] - x0[1]) + m[2] * (v1[2] - x0[2])) / length;
+                if (de == 0.0)
+                    continue;
+                const std::pair<int, int> key = std::minmax(loop[v], loop[v + 1]);
+                std::vector<double>& edge = edges[key];
+                if (edge.empty()) {
+                    edge.resize(size);
+                    _IntegrateEdgeMonomials<3>(vertices[key.first].data(), vertices[key.second].data(), derivatives, values.data(), edge.data());
+                }
+                for (size_t alpha = 0; alpha < size; ++alpha)
+                    face[alpha] += de * edge[alpha];
+            }
+            for (size_t alpha = 0; alpha < size; ++alpha) {
+                double sum = face[alpha];
+                for (int i = 0; i < 3; ++i) {
+                    const monIndex target = derivatives.Targets[alpha * 3 + i];
+                    if (target >= 0)
+                        sum += x0[i] * derivatives.Coefficients[alpha * 3 + i] * face[target];
+                }
+                face[alpha] = sum / (double)(2 + derivatives.Orders[alpha]);
+                integrals[alpha] += b * face[alpha];
+            }
+        }
+        for (size_t alpha = 0; alpha < size; ++alpha)
+            integrals[alpha] /= (double)(3 + derivatives.Orders[alpha]);
+        return integrals;
+    }
+}
+#endif
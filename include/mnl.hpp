@@ -9,21 +9,46 @@
                 Dimension of P_k(R^d)                           mnl::Poly<d>::SpaceDim(k);
                 Order of m_alpha                                mnl::Poly<d>::MonOrder(alpha);
                 Exponent of x_i in m_alpha                      mnl::Poly<d>::Exponent(alpha, i);
+                Exponents of all variables in m_alpha           mnl::Poly<d>::Exponents(alpha);
+                Index of monomial with exponents e              mnl::Poly<d>::Index(e);
                 Index of Product                                mnl::Poly<d>::Product(alpha, beta);
                 Index of Derivative in x_i                      mnl::Poly<d>::D(alpha, i);
                 Index of Antiderivative in x_i                  mnl::Poly<d>::AD(alpha, i);
 
             All operations are static member functions to class Poly<d>.
             Aliases are available up to d = 10, e.g., Poly<2> = Poly2D.
-            So far the limitation is that d+k < 20, but this can be revised with a refactoring of the factorial solution.
+            Indices are int by default, Poly<d, int64_t> supports spaces whose dimension does not fit in an int.
+            Dimensions come from exact binomial coefficients (Pascal's triangle), which are available as mnl::Binomial(n, k).
+            All of them use only integer arithmetic in the hot path and can be evaluated at compile time.
 
-            This is produced in C++11 and includes only <array>.
+            Monomials can also be represented by words with their packed exponents, mnl::PackedPoly<d>, for which products,
+            derivatives and antiderivatives are integer additions and subtractions. Exponents go up to PackedPoly<d>::MaxExponent,
+            2^(64/d) - 2, and exceeding it in Pack, Product or AD is caught by assert.
+
+            Monomials can be iterated over in index order, with their exponents updated incrementally:
+
+                All monomials of P_k(R^d)                       for (const auto& [alpha, order, e] : mnl::Monomials<d>(k))
+                Monomials of order k                            for (const auto& [alpha, order, e] : mnl::MonomialsOfOrder<d>(k))
+
+            For monomials up to a known order K, orders and exponents can be precomputed at compile time:
+
+                Lookup table for P_K(R^d)                       constexpr mnl::MonomialTable<d, K> table;
+                Order of m_alpha (table lookup)                 mnl::Poly<d>::MonOrder(alpha, table);
+                Exponent of x_i in m_alpha (table lookup)       mnl::Poly<d>::Exponent(alpha, i, table);
+
+            This is produced in C++17 and includes only <array>, <cassert>, <cstddef>, <cstdint>, <iterator>, <limits> and <type_traits>.
 
 **********************************************************************************************************************************/
 #pragma once
 #ifndef MNL
 #define MNL
 #include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
 
 namespace mnl {
     /*
@@ -32,43 +57,125 @@ namespace mnl {
     using monIndex = int;
     using monOrder = int;
 
+    template<const int d, const monOrder K>
+    struct MonomialTable;
+
     /*
-    *   This solution for factorials can be improved.
+    *   Factorials are only exact in int64_t up to 20!, binomials below do not rely on them.
     */
     constexpr std::array<int64_t, 21> _factorialTable = { 1,1,2,6,24,120,720,5040,40320,362880,3628800,39916800,479001600,6227020800,87178291200,1307674368000,20922789888000,355687428096000,6402373705728000,121645100408832000,2432902008176640000 };
     constexpr inline int64_t Factorial(const int n) { return _factorialTable[n]; }
 
-    constexpr int _Combination(const int n, const int k) {
-        if (k > n) return 0LL;
-        if (k == n || k == 0) return 1LL;
+    /*
+        Binomial coefficients from Pascal's triangle, C(n, k) = _binomialTable[n * _nBinomialRows + k].
+        All of them are exact in int64_t for n < 67.
+    */
+    constexpr int _nBinomialRows = 67;
 
-        double c = double(n);
-        for (int i = 2; i <= (k > (n - k) ? n - k : k); ++i)
-            c *= double(n + 1 - i) / double(i);
+    constexpr std::array<int64_t, _nBinomialRows * _nBinomialRows> _BuildBinomialTable() {
+        std::array<int64_t, _nBinomialRows * _nBinomialRows> table{};
+        for (int n = 0; n < _nBinomialRows; ++n) {
+            table[n * _nBinomialRows] = 1;
+            for (int k = 1; k <= n; ++k)
+                table[n * _nBinomialRows + k] = table[(n - 1) * _nBinomialRows + k - 1] + table[(n - 1) * _nBinomialRows + k];
+        }
+        return table;
+    }
+    inline constexpr std::array<int64_t, _nBinomialRows * _nBinomialRows> _binomialTable = _BuildBinomialTable();
 
-        return int(c + 0.5);
+    /*
+        Binomial coefficient C(n, k), looked up for n < 67.
+        Larger ones use the multiplicative formula, exact at each step, and are the caller's responsibility to fit in int64_t.
+    */
+    constexpr int64_t Binomial(const int n, const int k) {
+        if (k < 0 || k > n)
+            return 0;
+        if (n < _nBinomialRows)
+            return _binomialTable[n * _nBinomialRows + k];
+        const int m = (k > n - k ? n - k : k);
+        int64_t c = 1;
+        for (int i = 1; i <= m; ++i)
+            c = c * (n - m + i) / i;
+        return c;
     }
 
-    template<const int d>
+    constexpr int _Combination(const int n, const int k) { return (int)Binomial(n, k); }
+
+    /*
+        Dimension of P_k(R^d), C(k + d, d), saturated at the largest IndexT when it does not fit.
+    */
+    template<const int d, typename IndexT>
+    constexpr IndexT _SaturatedSpaceDim(const monOrder k) {
+        constexpr int64_t maxIndex = (int64_t)std::numeric_limits<IndexT>::max();
+        int64_t c = 1;
+        if (k + d < _nBinomialRows)
+            c = Binomial(k + d, d);
+        else
+            // C(k + i, i) = C(k + i - 1, i - 1) * (k + i) / i, for i = 1, ..., d, saturating once it no longer fits.
+            for (int i = 1; i <= d && c < maxIndex; ++i) {
+                const int64_t q = c / i, r = (c % i) * (k + i) / i;
+                c = (q > (maxIndex - r) / (k + i) ? maxIndex : q * (k + i) + r);
+            }
+        return (IndexT)(c > maxIndex ? maxIndex : c);
+    }
+
+    /*
+        Dimensions of P_k(R^d) for the first orders, used to search for the order of a monomial.
+        Entries that do not fit in IndexT are saturated.
+    */
+    constexpr int _nTabulatedOrders = 64;
+
+    template<const int d, typename IndexT>
+    constexpr std::array<IndexT, _nTabulatedOrders> _BuildSpaceDimTable() {
+        std::array<IndexT, _nTabulatedOrders> table{};
+        for (monOrder k = 0; k < _nTabulatedOrders; ++k)
+            table[k] = _SaturatedSpaceDim<d, IndexT>(k);
+        return table;
+    }
+    template<const int d, typename IndexT>
+    inline constexpr std::array<IndexT, _nTabulatedOrders> _spaceDimTable = _BuildSpaceDimTable<d, IndexT>();
+
+    /*
+        IndexT is the integer type of the indices, use Poly<d, int64_t> for spaces whose dimension does not fit in an int.
+    */
+    template<const int d, typename IndexT = monIndex>
     class Poly {
     public:
         /************************************************************
-            Dimension of space P_k(R^d)
+            Dimension of space P_k(R^d), saturated at the largest
+            IndexT when it does not fit.
         ************************************************************/
-        constexpr static int SpaceDim(const monOrder k) {
-            //return (k < 0 ? 0 : Factorial(k + d) / (Factorial(k) * Factorial(d)));
-            return (k < 0 ? 0 : _Combination(k + d, d));
+        constexpr static IndexT SpaceDim(const monOrder k) {
+            return (k < 0 ? 0 : (k < _nTabulatedOrders ? _spaceDimTable<d, IndexT>[k] : _SaturatedSpaceDim<d, IndexT>(k)));
         }
 
         /************************************************************
             Returns the order (sum of the exponents) of a given monomial.
+            Branch-free binary search for the first k with
+            alpha < SpaceDim(k), exponential search past the tabulated orders.
         ************************************************************/
-        static monOrder MonOrder(const monIndex alpha) {
-            // preciso fazer o esquema de ir tirando um de cada vez.
-            monOrder k = std::max(0, (int)ceil(pow((double)(Factorial(d) * (alpha + 1)), 1.0 / d) - d));
-            while (alpha >= SpaceDim(k)) {
-                ++k;
+        constexpr static monOrder MonOrder(const IndexT alpha) {
+            const std::array<IndexT, _nTabulatedOrders>& spaceDims = _spaceDimTable<d, IndexT>;
+            if (alpha >= spaceDims[_nTabulatedOrders - 1]) {
+                // The doubling stops once SpaceDim(hi) saturates, as every valid index is below it.
+                constexpr IndexT maxIndex = std::numeric_limits<IndexT>::max();
+                monOrder lo = _nTabulatedOrders, hi = 2 * _nTabulatedOrders;
+                while (alpha >= SpaceDim(hi) && SpaceDim(hi) < maxIndex && hi <= std::numeric_limits<monOrder>::max() / 2) {
+                    lo = hi + 1;
+                    hi *= 2;
+                }
+                while (lo < hi) {
+                    const monOrder mid = lo + (hi - lo) / 2;
+                    if (alpha < SpaceDim(mid))
+                        hi = mid;
+                    else
+                        lo = mid + 1;
+                }
+                return lo;
             }
+            monOrder k = 0;
+            for (monOrder step = _nTabulatedOrders / 2; step > 0; step /= 2)
+                k += (spaceDims[k + step - 1] <= alpha ? step : 0);
             return k;
         }
 
@@ -76,22 +183,44 @@ namespace mnl {
             Exponent of x_variable of monomial of index alpha.
             variable < d
         ************************************************************/
-        constexpr static int Exponent(monIndex alpha, int variable) {
+        constexpr static int Exponent(IndexT alpha, int variable) {
             const monOrder k = MonOrder(alpha);
-            const monIndex innerIndex = alpha - (monIndex)SpaceDim(k - 1);
-            return (variable == 0 ? (int)(k - Poly<d - 1>::MonOrder(innerIndex)) : Poly<d - 1>::Exponent(innerIndex, variable - 1));
+            const IndexT innerIndex = alpha - SpaceDim(k - 1);
+            return (variable == 0 ? (int)(k - Poly<d - 1, IndexT>::MonOrder(innerIndex)) : Poly<d - 1, IndexT>::Exponent(innerIndex, variable - 1));
+        }
+
+        /************************************************************
+            Exponents of all variables of monomial of index alpha,
+            decoded in a single pass through the recursion.
+            alpha >= 0
+        ************************************************************/
+        constexpr static std::array<int, d> Exponents(const IndexT alpha) {
+            std::array<int, d> e{};
+            _Exponents(alpha, MonOrder(alpha), e.data());
+            return e;
+        }
+
+        /************************************************************
+            Index of the monomial with exponents e, i.e., the inverse
+            of Exponents: Index(Exponents(alpha)) = alpha.
+        ************************************************************/
+        constexpr static IndexT Index(const std::array<int, d>& e) {
+            monOrder k = 0;
+            for (int i = 0; i < d; ++i)
+                k += e[i];
+            return _Index(e.data(), k);
         }
 
         /************************************************************
             Product of monomials alpha and beta
             m_alpha * m_beta = m_gamma -> Product(alpha, beta) = gamma
         ************************************************************/
-        constexpr static monIndex Product(const monIndex alpha, const monIndex beta) {
+        constexpr static IndexT Product(const IndexT alpha, const IndexT beta) {
             if (alpha == -1 || beta == -1)
                 return -1;
             const monOrder kalpha = MonOrder(alpha);
             const monOrder kbeta = MonOrder(beta);
-            return Poly<d - 1>::Product(alpha - SpaceDim(kalpha - 1), beta - SpaceDim(kbeta - 1)) + SpaceDim(kalpha + kbeta - 1);
+            return Poly<d - 1, IndexT>::Product(alpha - SpaceDim(kalpha - 1), beta - SpaceDim(kbeta - 1)) + SpaceDim(kalpha + kbeta - 1);
         }
 
 
@@ -99,23 +228,20 @@ namespace mnl {
             Derivative of monomial alpha in the direction of variable
             d/dxi(m_alpha) = C m_beta  -> D(alpha, i) = beta
         ************************************************************/
-        constexpr static monIndex D(const monIndex alpha, const int variable) {
+        constexpr static IndexT D(const IndexT alpha, const int variable) {
             // Kernel for constants
             if (alpha == 0 || alpha == -1)
                 return -1;
             const monOrder kalpha = MonOrder(alpha);
-            const monIndex innerIndex = alpha - SpaceDim(kalpha - 1);
-            const monOrder kInner = Poly<d - 1>::MonOrder(innerIndex);
-            // if (kInner == kalpha)
-            //     return -1;
+            const IndexT innerIndex = alpha - SpaceDim(kalpha - 1);
             if (variable == 0) {
-                if (innerIndex >= Poly<d - 1>::SpaceDim(kalpha - 1))
+                if (innerIndex >= Poly<d - 1, IndexT>::SpaceDim(kalpha - 1))
                     return -1;
                 else
                     return innerIndex + SpaceDim(kalpha - 2);
             }
 
-            const monIndex dInner = Poly<d - 1>::D(innerIndex, variable - 1);
+            const IndexT dInner = Poly<d - 1, IndexT>::D(innerIndex, variable - 1);
             if (dInner == -1)
                 return dInner;
             return dInner + SpaceDim(kalpha - 2);
@@ -125,22 +251,269 @@ namespace mnl {
             Antiderivative of monomial alpha in the direction of variable
             d/dxi(m_beta) = C m_alpha  -> AD(alpha, i) = beta
         ************************************************************/
-        constexpr static monIndex AD(const monIndex alpha, const int variable) {
+        constexpr static IndexT AD(const IndexT alpha, const int variable) {
             if (alpha == -1)
                 return 0;
             const monOrder kalpha = MonOrder(alpha);
-            return (variable == 0 ? alpha + Poly<d - 1>::SpaceDim(kalpha) : Poly<d - 1>::AD(alpha - SpaceDim(kalpha - 1), variable - 1) + SpaceDim(kalpha));
+            return (variable == 0 ? alpha + Poly<d - 1, IndexT>::SpaceDim(kalpha) : Poly<d - 1, IndexT>::AD(alpha - SpaceDim(kalpha - 1), variable - 1) + SpaceDim(kalpha));
+        }
+
+        /************************************************************
+            Table-based overloads, O(1) for alpha < SpaceDim(K).
+            Indices outside the table fall back to the recursion.
+        ************************************************************/
+        template<const monOrder K>
+        constexpr static monOrder MonOrder(const IndexT alpha, const MonomialTable<d, K>& table) {
+            return (alpha >= 0 && alpha < table.Size ? table.Order((monIndex)alpha) : MonOrder(alpha));
+        }
+        template<const monOrder K>
+        constexpr static int Exponent(const IndexT alpha, const int variable, const MonomialTable<d, K>& table) {
+            return (alpha >= 0 && alpha < table.Size ? table.Exponent((monIndex)alpha, variable) : Exponent(alpha, variable));
+        }
+
+    private:
+        friend class Poly<d + 1, IndexT>;
+
+        /*
+            Recursion for Exponents and Index, with the order k of the monomial already known.
+        */
+        constexpr static void _Exponents(const IndexT alpha, const monOrder k, int* e) {
+            const IndexT innerIndex = alpha - SpaceDim(k - 1);
+            const monOrder kInner = Poly<d - 1, IndexT>::MonOrder(innerIndex);
+            e[0] = (int)(k - kInner);
+            Poly<d - 1, IndexT>::_Exponents(innerIndex, kInner, e + 1);
+        }
+        constexpr static IndexT _Index(const int* e, const monOrder k) {
+            return SpaceDim(k - 1) + Poly<d - 1, IndexT>::_Index(e + 1, k - e[0]);
+        }
+    };
+    template<typename IndexT>
+    class Poly<1, IndexT> {
+    public:
+        constexpr static IndexT     SpaceDim(const monOrder k) { return (IndexT)k + 1; }
+        constexpr static monOrder   MonOrder(const IndexT alpha) { return (monOrder)alpha; }
+        constexpr static int        Exponent(const IndexT alpha, const int variable) { return (int)alpha; }
+        constexpr static IndexT     Product(const IndexT alpha, const IndexT beta) { return alpha + beta; }
+        constexpr static IndexT     D(const IndexT alpha, const int variable) { return alpha - (IndexT)1; }
+        constexpr static IndexT     AD(const IndexT alpha, const int variable) { return alpha + 1; }
+        constexpr static std::array<int, 1> Exponents(const IndexT alpha) { return { (int)alpha }; }
+        constexpr static IndexT     Index(const std::array<int, 1>& e) { return (IndexT)e[0]; }
+
+        template<const monOrder K>
+        constexpr static monOrder   MonOrder(const IndexT alpha, const MonomialTable<1, K>& table) { return (monOrder)alpha; }
+        template<const monOrder K>
+        constexpr static int        Exponent(const IndexT alpha, const int variable, const MonomialTable<1, K>& table) { return (int)alpha; }
+
+    private:
+        friend class Poly<2, IndexT>;
+
+        constexpr static void       _Exponents(const IndexT alpha, const monOrder, int* e) { e[0] = (int)alpha; }
+        constexpr static IndexT     _Index(const int*, const monOrder k) { return (IndexT)k; }
+    };
+
+    /************************************************************
+        Advances exponents e of a monomial of order k to the ones
+        of the next monomial (alpha + 1), updating k if needed.
+    ************************************************************/
+    template<const int d>
+    constexpr void _NextExponents(std::array<int, d>& e, monOrder& k) {
+        int i = d - 2;
+        while (i >= 0 && e[i] == 0)
+            --i;
+        // Last monomial of order k, i.e., x_(d-1)^k.
+        if (i < 0) {
+            e[d - 1] = 0;
+            e[0] = ++k;
+            return;
         }
+        const int last = e[d - 1];
+        --e[i];
+        e[d - 1] = 0;
+        e[i + 1] = last + 1;
+    }
+
+    /************************************************************
+        Forward iteration over monomials in index order, yielding
+        index, order and exponents, e.g.,
+            for (const auto& [alpha, k, e] : Monomials<d>(kmax))
+        Exponents are decoded once, at the first monomial, and
+        updated incrementally afterwards.
+    ************************************************************/
+    template<const int d>
+    struct MonomialEntry {
+        monIndex            Index;
+        monOrder            Order;
+        std::array<int, d>  Exponents;
+    };
+
+    template<const int d>
+    class MonomialIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = MonomialEntry<d>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const MonomialEntry<d>*;
+        using reference = const MonomialEntry<d>&;
+
+        constexpr MonomialIterator() : _entry{ 0, 0, {} } {}
+        constexpr explicit MonomialIterator(const monIndex alpha) : _entry{ alpha, Poly<d>::MonOrder(alpha), Poly<d>::Exponents(alpha) } {}
+
+        constexpr reference operator*() const { return _entry; }
+        constexpr pointer operator->() const { return &_entry; }
+        constexpr MonomialIterator& operator++() {
+            ++_entry.Index;
+            _NextExponents<d>(_entry.Exponents, _entry.Order);
+            return *this;
+        }
+        constexpr MonomialIterator operator++(int) {
+            MonomialIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+        constexpr bool operator==(const MonomialIterator& other) const { return _entry.Index == other._entry.Index; }
+        constexpr bool operator!=(const MonomialIterator& other) const { return _entry.Index != other._entry.Index; }
+
+    private:
+        MonomialEntry<d> _entry;
+
+        template<const int dd>
+        friend class MonomialRange;
+        // Past-the-end iterator, only its index is used.
+        struct _EndTag {};
+        constexpr MonomialIterator(const monIndex alpha, _EndTag) : _entry{ alpha, 0, {} } {}
     };
-    template<>
-    class Poly<1> {
+
+    template<const int d>
+    class MonomialRange {
     public:
-        constexpr static int        SpaceDim(const monOrder k) { return (int)k + 1; }
-        constexpr static monOrder   MonOrder(const monIndex alpha) { return (monOrder)alpha; }
-        constexpr static int        Exponent(const monIndex alpha, const int variable) { return alpha; }
-        constexpr static monIndex   Product(const monIndex alpha, const monIndex beta) { return alpha + beta; }
-        constexpr static monIndex   D(const monIndex alpha, const int variable) { return alpha - (monIndex)1; }
-        constexpr static monIndex   AD(const monIndex alpha, const int variable) { return alpha + 1; }
+        // Monomials m_first, ..., m_(last - 1).
+        constexpr MonomialRange(const monIndex first, const monIndex last) : _first(first), _last(last < first ? first : last) {}
+
+        constexpr MonomialIterator<d>   begin() const { return (_first < _last ? MonomialIterator<d>(_first) : end()); }
+        constexpr MonomialIterator<d>   end() const { return MonomialIterator<d>(_last, typename MonomialIterator<d>::_EndTag{}); }
+        constexpr monIndex              size() const { return _last - _first; }
+
+    private:
+        monIndex _first;
+        monIndex _last;
+    };
+
+    /************************************************************
+        All monomials of P_k(R^d).
+    ************************************************************/
+    template<const int d>
+    constexpr MonomialRange<d> Monomials(const monOrder k) { return MonomialRange<d>(0, Poly<d>::SpaceDim(k)); }
+
+    /************************************************************
+        Monomials of order exactly k.
+    ************************************************************/
+    template<const int d>
+    constexpr MonomialRange<d> MonomialsOfOrder(const monOrder k) { return MonomialRange<d>(Poly<d>::SpaceDim(k - 1), Poly<d>::SpaceDim(k)); }
+
+    /************************************************************
+        Orders and exponents of all monomials in P_K(R^d).
+        Stored as structure of arrays: Orders[alpha] and
+        Exponents[variable][alpha].
+    ************************************************************/
+    template<const int d, const monOrder K>
+    struct MonomialTable {
+        using value_type = typename std::conditional<(K < 256), uint8_t, uint16_t>::type;
+        static constexpr monIndex Size = Poly<d>::SpaceDim(K);
+
+        std::array<value_type, Size> Orders{};
+        std::array<std::array<value_type, Size>, d> Exponents{};
+
+        constexpr MonomialTable() {
+            std::array<int, d> e{};
+            monOrder k = 0;
+            for (monIndex alpha = 0; alpha < Size; ++alpha) {
+                Orders[alpha] = (value_type)k;
+                for (int i = 0; i < d; ++i)
+                    Exponents[i][alpha] = (value_type)e[i];
+                _NextExponents<d>(e, k);
+            }
+        }
+
+        constexpr monOrder  Order(const monIndex alpha) const { return (monOrder)Orders[alpha]; }
+        constexpr int       Exponent(const monIndex alpha, const int variable) const { return (int)Exponents[variable][alpha]; }
+    };
+
+    /************************************************************
+        Monomials as exponent words, with the exponent of x_i packed
+        in bits [i * Bits, (i + 1) * Bits) of a 64-bit integer.
+        Products, derivatives and antiderivatives become integer
+        additions and subtractions.
+    ************************************************************/
+    using monWord = uint64_t;
+
+    template<const int d>
+    class PackedPoly {
+    public:
+        static_assert(d >= 1 && d <= 64, "Exponent words hold up to 64 variables.");
+        // Bits per variable, at least 8 for d <= 8.
+        static constexpr int        Bits = 64 / d;
+        // Word with all bits set is reserved for zero, i.e., m_-1.
+        static constexpr monWord    Zero = ~monWord(0);
+        // Largest exponent of each variable, 2^Bits - 2, so that no monomial is packed into Zero.
+        static constexpr monWord    MaxExponent = (Bits == 64 ? ~monWord(0) : (monWord(1) << Bits) - 1) - 1;
+
+        /*
+            0 <= e[i] <= MaxExponent
+        */
+        constexpr static monWord Pack(const std::array<int, d>& e) {
+            monWord m = 0;
+            for (int i = 0; i < d; ++i) {
+                assert(e[i] >= 0 && monWord(e[i]) <= MaxExponent);
+                m |= monWord(e[i]) << (i * Bits);
+            }
+            return m;
+        }
+        constexpr static std::array<int, d> Unpack(const monWord m) {
+            std::array<int, d> e{};
+            for (int i = 0; i < d; ++i)
+                e[i] = Exponent(m, i);
+            return e;
+        }
+
+        constexpr static int        Exponent(const monWord m, const int variable) { return (int)((m >> (variable * Bits)) & _mask); }
+        constexpr static monOrder   MonOrder(const monWord m) {
+            monOrder k = 0;
+            for (int i = 0; i < d; ++i)
+                k += Exponent(m, i);
+            return k;
+        }
+        constexpr static monWord    D(const monWord m, const int variable) { return (m == Zero || Exponent(m, variable) == 0 ? Zero : m - _Unit(variable)); }
+
+        /************************************************************
+            Product and antiderivative add the exponents without
+            carrying between variables: the exponents of the result
+            must not exceed MaxExponent, which is checked by assert.
+        ************************************************************/
+        constexpr static monWord Product(const monWord a, const monWord b) {
+            if (a == Zero || b == Zero)
+                return Zero;
+            for (int i = 0; i < d; ++i)
+                assert(monWord(Exponent(a, i)) <= MaxExponent - monWord(Exponent(b, i)));
+            return a + b;
+        }
+        constexpr static monWord AD(const monWord m, const int variable) {
+            if (m == Zero)
+                return 0;
+            assert(monWord(Exponent(m, variable)) < MaxExponent);
+            return m + _Unit(variable);
+        }
+
+        /************************************************************
+            Conversions from and to the indices of Poly<d>.
+        ************************************************************/
+        template<typename IndexT = monIndex>
+        constexpr static monWord FromIndex(const IndexT alpha) { return (alpha == -1 ? Zero : Pack(Poly<d, IndexT>::Exponents(alpha))); }
+        template<typename IndexT = monIndex>
+        constexpr static IndexT ToIndex(const monWord m) { return (m == Zero ? -1 : Poly<d, IndexT>::Index(Unpack(m))); }
+
+    private:
+        static constexpr monWord _mask = (Bits == 64 ? ~monWord(0) : (monWord(1) << Bits) - 1);
+        constexpr static monWord _Unit(const int variable) { return monWord(1) << (variable * Bits); }
     };
 
     #define ALIASPSpace(d) using PSpace ##d ##D = Poly<d>
@@ -10,6 +10,12 @@
                 Order of polynomial                             p1.Order();
                 Addition                                        p3 = p1 + p2; p1 += p2;
                 Multiplication                                  p3 = p1*p2; p1 *= p2;
+                Multiplication with a ProductTable<d, K>        p3 = Multiply(p1, p2, table);
+                Operations reusing the storage of p3            MultiplyInto(p3, p1, p2); AddInto(p3, p1, p2);
+                Part of p1*p2 up to order K                     p3 = MultiplyTruncated(p1, p2, K);
+                Fused evaluation of an expression               p3 = Lazy(p1) * Lazy(p2) + 2.0 * Lazy(p3);
+                Change of variables, p3(x) = p1(x - c)          p3 = p1.Translate(c);
+                Change of variables, p3(x) = p1(x / h)          p3 = p1.Scale(h);
             
             Terms in the monomial are stored in an unordered map with a monIndex as key and double as value.
             The map is directly exposed as: p.Terms;
@@ -27,21 +33,59 @@
                 // Do work...
             }
 
+            The map is the second template argument of Polynomial<d, Map>, std::unordered_map<monIndex, double> by default.
+            Maps with the same interface can be used instead, e.g., the open-addressing table in hmp.hpp, which keeps all terms in a
+            single array and avoids allocating a node per term: mnl::Polynomial<d, mnl::OpenHashMap<monIndex, double>>.
+            Unlike std::unordered_map, erasing from an OpenHashMap while iterating, it = Terms.erase(it), may visit again the
+            entries that wrapped around the end of its array; CheckZeroes only erases, so a second visit is harmless, but a loop
+            that accumulates while erasing must not rely on visiting each term once.
+
+            Polynomials can be constructed with the allocator of their map, which the results of their operations inherit.
+            MultiplyInto and AddInto clear and refill the map of their output, so, in a loop over elements, they do not allocate
+            once its storage has grown, with OpenHashMap, or when the nodes come from a pool, with mnl::PmrPolynomial<d>
+            (std::pmr::unordered_map) constructed with a std::pmr::unsynchronized_pool_resource.
+
+            Translate shifts one variable at a time with the binomial expansion of (x_i - c_i)^n, so it costs O(d N k) for N terms
+            of order up to k, instead of expanding the products of the terms. Local coordinates of an element, (x - x_E) / h_E, are
+            obtained as p.Scale(h_E).Translate(x_E), so that the result evaluated at x is p((x - x_E) / h_E).
+
             Aliases are available for the Polynomial<d> struct as pnldD up to d = 10, e.g., Polynomial<2> = pnl2D.
 
-            This is produced in C++11 and includes only <array> and <unordered_map>.
+            For sparse polynomials iterated often, mnl::FlatPolynomial<d> has the same operations but stores the terms as pairs
+            of monomial index and scalar in a single vector sorted by index, p.Terms, so that iteration follows the order of the
+            monomials and no term is allocated on its own. Addition is a linear merge of the terms, while multiplication gathers
+            all partial products and then sorts and combines them.
+
+                Flat polynomial from (index, scalar) pairs      mnl::FlatPolynomial<d> p({{alpha, a}, {beta, b}});
+                Coefficient of m_alpha (binary search)          p.Coefficient(alpha);
+                Conversion from and to Polynomial<d>            mnl::FlatPolynomial<d> p(sparse); sparse = p.ToSparse();
+
+            This is produced in C++17 and includes only <algorithm>, <array>, <cmath>, <memory_resource>, <type_traits>, <utility>, <vector> and <unordered_map>.
 
 **********************************************************************************************************************************/
 #pragma once
 #ifndef PNL
 #define PNL
 #include "mnl.hpp"
+#include "tbl.hpp"
+#include "hmp.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory_resource>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace mnl {
-    template <int d>
+    struct _LazyExpression {};
+
+    template <int d, typename Map = std::unordered_map<monIndex, double>>
     struct Polynomial {
-        std::unordered_map<monIndex, double> Terms;
+        Map Terms;
+
+        Polynomial() = default;
+        explicit Polynomial(const typename Map::allocator_type& allocator) : Terms(allocator) {}
 
         monOrder Order() const {
             monIndex maxIndex = -1;
@@ -52,16 +96,61 @@ namespace mnl {
             return Poly<d>::MonOrder(maxIndex);
         }
 
-        Polynomial<d>& operator*=(const Polynomial<d>& p) {
-            Polynomial<d> aux;
-            for (const auto& it1 : Terms)
-                for (const auto& it2 : p.Terms)
-                    aux.Terms[Poly<d>::Product(it1.first, it2.first)] += it1.second * it2.second;
-            Terms = aux.Terms;
-            CheckZeroes();
-            return *this;
+        template<typename Expression, typename = std::enable_if_t<std::is_base_of_v<_LazyExpression, Expression>>>
+        Polynomial<d, Map>& operator=(const Expression& expression);
+        template<typename Expression, typename = std::enable_if_t<std::is_base_of_v<_LazyExpression, Expression>>>
+        Polynomial<d, Map>& operator+=(const Expression& expression);
+
+        Polynomial<d, Map>& operator*=(const Polynomial<d, Map>& p);
+
+        /************************************************************
+            Polynomial q(x) = p(x - c), shifting one variable at a
+            time: each term a x_i^n of the previous variables' result
+            spreads to a C(n, j) (-c_i)^(n - j) x_i^j, j <= n.
+            Costs O(d N k) for N terms of order up to k.
+        ************************************************************/
+        Polynomial<d, Map> Translate(const std::array<double, d>& c) const {
+            Polynomial<d, Map> result(*this), shifted(Terms.get_allocator());
+            std::vector<double> powers((size_t)std::max(Order(), 0) + 1);
+            for (int i = 0; i < d; ++i) {
+                if (c[i] == 0.0)
+                    continue;
+                powers[0] = 1.0;
+                for (size_t m = 1; m < powers.size(); ++m)
+                    powers[m] = -c[i] * powers[m - 1];
+                shifted.Terms.clear();
+                for (const auto& it : result.Terms) {
+                    const int n = Poly<d>::Exponent(it.first, i);
+                    monIndex target = it.first;
+                    for (int j = n; j >= 0; --j) {
+                        shifted.Terms[target] += (double)Binomial(n, j) * powers[n - j] * it.second;
+                        if (j > 0)
+                            target = Poly<d>::D(target, i);
+                    }
+                }
+                result.Terms.swap(shifted.Terms);
+            }
+            result.CheckZeroes();
+            return result;
+        }
+
+        /************************************************************
+            Polynomial q(x) = p(x / h), the coefficient of m_alpha
+            being multiplied by h^-|alpha|.
+        ************************************************************/
+        Polynomial<d, Map> Scale(const double h) const {
+            Polynomial<d, Map> result(*this);
+            std::vector<double> powers((size_t)std::max(Order(), 0) + 1);
+            powers[0] = 1.0;
+            for (size_t m = 1; m < powers.size(); ++m)
+                powers[m] = powers[m - 1] / h;
+            for (auto& it : result.Terms)
+                it.second *= powers[Poly<d>::MonOrder(it.first)];
+            result.CheckZeroes();
+            return result;
         }
-        Polynomial<d>& operator+=(const Polynomial<d>& p) {
+
+        Polynomial<d, Map>& operator+=(const Polynomial<d, Map>& p) {
             for (const auto& it : p.Terms)
                 Terms[it.first] += it.second;
             CheckZeroes();
@@ -70,7 +159,7 @@ namespace mnl {
         void CheckZeroes() {
             for (auto it = Terms.begin(); it != Terms.end();)
             {
-                if (abs(it->second) < 1e-10)
+                if (std::abs(it->second) < 1e-10)
                     it = Terms.erase(it);
                 else
                     ++it;
@@ -78,16 +167,354 @@ namespace mnl {
         }
     };
 
-    template<int d>
-    Polynomial<d> operator*(const Polynomial<d>& p1, const Polynomial<d>& p2) {
-        Polynomial<d> result;
+    /*
+        out = p1 * p2, reusing the storage of out (clearing std::unordered_map keeps its buckets, clearing OpenHashMap keeps its slots).
+        out may be p1 or p2, in which case the product goes through a temporary with the allocator of out.
+    */
+    template<int d, typename Map>
+    void MultiplyInto(Polynomial<d, Map>& out, const Polynomial<d, Map>& p1, const Polynomial<d, Map>& p2) {
+        if (&out == &p1 || &out == &p2) {
+            Polynomial<d, Map> aux(out.Terms.get_allocator());
+            MultiplyInto(aux, p1, p2);
+            out.Terms.swap(aux.Terms);
+            return;
+        }
+        out.Terms.clear();
         for (const auto& it1 : p1.Terms)
             for (const auto& it2 : p2.Terms)
-                result.Terms[Poly<d>::Product(it1.first, it2.first)] += it1.second * it2.second;
+                out.Terms[Poly<d>::Product(it1.first, it2.first)] += it1.second * it2.second;
+        out.CheckZeroes();
+    }
+
+    /*
+        out = p1 + p2, reusing the storage of out, which may be p1 or p2.
+    */
+    template<int d, typename Map>
+    void AddInto(Polynomial<d, Map>& out, const Polynomial<d, Map>& p1, const Polynomial<d, Map>& p2) {
+        if (&out == &p2) {
+            out += p1;
+            return;
+        }
+        if (&out != &p1) {
+            out.Terms.clear();
+            for (const auto& it : p1.Terms)
+                out.Terms[it.first] = it.second;
+        }
+        out += p2;
+    }
+
+    template<int d, typename Map>
+    Polynomial<d, Map>& Polynomial<d, Map>::operator*=(const Polynomial<d, Map>& p) {
+        MultiplyInto(*this, *this, p);
+        return *this;
+    }
+
+    template<int d, typename Map>
+    Polynomial<d, Map> operator*(const Polynomial<d, Map>& p1, const Polynomial<d, Map>& p2) {
+        Polynomial<d, Map> result(p1.Terms.get_allocator());
+        MultiplyInto(result, p1, p2);
+        return result;
+    }
+
+    template<int d, typename Map>
+    Polynomial<d, Map> operator+(const Polynomial<d, Map>& p1, const Polynomial<d, Map>& p2) {
+        Polynomial<d, Map> result(p1.Terms.get_allocator());
+        AddInto(result, p1, p2);
+        return result;
+    }
+
+    /*
+        Lazy expressions: Lazy(p) wraps a polynomial, and +, -, * and scaling of wrapped polynomials record the expression
+        instead of computing it. Assigning it to a polynomial, or adding it to one, evaluates it in a single pass that
+        accumulates every term directly into the destination, pruning null terms only once at the end:
+            p = Lazy(a) * Lazy(b) + Lazy(c) * Lazy(d);
+        Operands of products that are not wrapped polynomials are evaluated into a temporary map first.
+        Expressions keep references to the wrapped polynomials, which must outlive them.
+        When the destination appears in the expression, it is evaluated into a temporary that is then swapped in.
+    */
+    template<int d, typename Map>
+    struct _LazyPolynomial : _LazyExpression {
+        static constexpr int dimension = d;
+        using map_type = Map;
+        const Polynomial<d, Map>& P;
+
+        explicit _LazyPolynomial(const Polynomial<d, Map>& p) : P(p) {}
+        bool _References(const void* terms) const { return &P.Terms == terms; }
+        void _AccumulateInto(Map& out, const double scale) const {
+            for (const auto& it : P.Terms)
+                out[it.first] += scale * it.second;
+        }
+    };
+
+    template<typename Left, typename Right>
+    struct _LazySum : _LazyExpression {
+        static constexpr int dimension = Left::dimension;
+        using map_type = typename Left::map_type;
+        Left L;
+        Right R;
+
+        _LazySum(const Left& l, const Right& r) : L(l), R(r) {}
+        bool _References(const void* terms) const { return L._References(terms) || R._References(terms); }
+        void _AccumulateInto(map_type& out, const double scale) const {
+            L._AccumulateInto(out, scale);
+            R._AccumulateInto(out, scale);
+        }
+    };
+
+    template<typename Expression>
+    struct _LazyScale : _LazyExpression {
+        static constexpr int dimension = Expression::dimension;
+        using map_type = typename Expression::map_type;
+        Expression E;
+        double Scalar;
+
+        _LazyScale(const Expression& e, const double scalar) : E(e), Scalar(scalar) {}
+        bool _References(const void* terms) const { return E._References(terms); }
+        void _AccumulateInto(map_type& out, const double scale) const { E._AccumulateInto(out, scale * Scalar); }
+    };
+
+    /*
+        Terms of an operand of a product: those of the polynomial itself when it is wrapped, or evaluated otherwise.
+    */
+    template<int d, typename Map>
+    const Map& _LazyTerms(const _LazyPolynomial<d, Map>& e, const Map&) { return e.P.Terms; }
+    template<typename Expression>
+    typename Expression::map_type _LazyTerms(const Expression& e, const typename Expression::map_type& out) {
+        typename Expression::map_type terms(out.get_allocator());
+        e._AccumulateInto(terms, 1.0);
+        return terms;
+    }
+
+    template<int d, typename Left, typename Right>
+    struct _LazyProduct : _LazyExpression {
+        static constexpr int dimension = d;
+        using map_type = typename Left::map_type;
+        Left L;
+        Right R;
+
+        _LazyProduct(const Left& l, const Right& r) : L(l), R(r) {}
+        bool _References(const void* terms) const { return L._References(terms) || R._References(terms); }
+        void _AccumulateInto(map_type& out, const double scale) const {
+            const map_type& left = _LazyTerms(L, out);
+            const map_type& right = _LazyTerms(R, out);
+            for (const auto& it1 : left)
+                for (const auto& it2 : right)
+                    out[Poly<d>::Product(it1.first, it2.first)] += scale * it1.second * it2.second;
+        }
+    };
+
+    template<typename Expression>
+    constexpr bool _isLazy = std::is_base_of_v<_LazyExpression, Expression>;
+
+    template<int d, typename Map>
+    _LazyPolynomial<d, Map> Lazy(const Polynomial<d, Map>& p) { return _LazyPolynomial<d, Map>(p); }
+
+    template<typename Left, typename Right, typename = std::enable_if_t<_isLazy<Left> && _isLazy<Right>>>
+    _LazySum<Left, Right> operator+(const Left& l, const Right& r) { return _LazySum<Left, Right>(l, r); }
+    template<typename Left, typename Right, typename = std::enable_if_t<_isLazy<Left> && _isLazy<Right>>>
+    _LazySum<Left, _LazyScale<Right>> operator-(const Left& l, const Right& r) { return _LazySum<Left, _LazyScale<Right>>(l, _LazyScale<Right>(r, -1.0)); }
+    template<typename Expression, typename = std::enable_if_t<_isLazy<Expression>>>
+    _LazyScale<Expression> operator*(const double scalar, const Expression& e) { return _LazyScale<Expression>(e, scalar); }
+    template<typename Expression, typename = std::enable_if_t<_isLazy<Expression>>>
+    _LazyScale<Expression> operator*(const Expression& e, const double scalar) { return _LazyScale<Expression>(e, scalar); }
+    template<typename Left, typename Right, typename = std::enable_if_t<_isLazy<Left> && _isLazy<Right>>>
+    _LazyProduct<Left::dimension, Left, Right> operator*(const Left& l, const Right& r) { return _LazyProduct<Left::dimension, Left, Right>(l, r); }
+
+    template<int d, typename Map>
+    template<typename Expression, typename>
+    Polynomial<d, Map>& Polynomial<d, Map>::operator=(const Expression& expression) {
+        if (expression._References(&Terms)) {
+            Polynomial<d, Map> aux(Terms.get_allocator());
+            expression._AccumulateInto(aux.Terms, 1.0);
+            Terms.swap(aux.Terms);
+        }
+        else {
+            Terms.clear();
+            expression._AccumulateInto(Terms, 1.0);
+        }
+        CheckZeroes();
+        return *this;
+    }
+
+    template<int d, typename Map>
+    template<typename Expression, typename>
+    Polynomial<d, Map>& Polynomial<d, Map>::operator+=(const Expression& expression) {
+        if (expression._References(&Terms)) {
+            Polynomial<d, Map> aux(Terms.get_allocator());
+            expression._AccumulateInto(aux.Terms, 1.0);
+            for (const auto& it : aux.Terms)
+                Terms[it.first] += it.second;
+        }
+        else
+            expression._AccumulateInto(Terms, 1.0);
+        CheckZeroes();
+        return *this;
+    }
+
+    /*
+        Product looking up the indices in a ProductTable instead of recursing through Poly<d>::Product.
+    */
+    template<int d, typename Map, monOrder K>
+    Polynomial<d, Map> Multiply(const Polynomial<d, Map>& p1, const Polynomial<d, Map>& p2, const ProductTable<d, K>& table) {
+        Polynomial<d, Map> result(p1.Terms.get_allocator());
+        for (const auto& it1 : p1.Terms)
+            for (const auto& it2 : p2.Terms)
+                result.Terms[table.Product(it1.first, it2.first)] += it1.second * it2.second;
+        result.CheckZeroes();
+        return result;
+    }
+
+    /*
+        Part of p1 * p2 up to order K. As the monomials are ordered by order, m_beta can only multiply m_alpha when
+        beta < SpaceDim(K - MonOrder(alpha)), so the other pairs are skipped by a comparison before computing the index of their product.
+    */
+    template<int d, typename Map>
+    Polynomial<d, Map> MultiplyTruncated(const Polynomial<d, Map>& p1, const Polynomial<d, Map>& p2, const monOrder K) {
+        Polynomial<d, Map> result(p1.Terms.get_allocator());
+        for (const auto& it1 : p1.Terms) {
+            const monOrder k1 = Poly<d>::MonOrder(it1.first);
+            if (k1 > K)
+                continue;
+            const monIndex bound = Poly<d>::SpaceDim(K - k1);
+            for (const auto& it2 : p2.Terms)
+                if (it2.first < bound)
+                    result.Terms[Poly<d>::Product(it1.first, it2.first)] += it1.second * it2.second;
+        }
         result.CheckZeroes();
         return result;
     }
 
+    /*
+        Sorts the terms by index, adding the scalars of repeated indices and removing null ones.
+    */
+    inline void _SortAndCombine(std::vector<std::pair<monIndex, double>>& terms) {
+        std::sort(terms.begin(), terms.end(), [](const std::pair<monIndex, double>& a, const std::pair<monIndex, double>& b) { return a.first < b.first; });
+        size_t n = 0;
+        for (size_t i = 0; i < terms.size();) {
+            const monIndex index = terms[i].first;
+            double scalar = 0.0;
+            for (; i < terms.size() && terms[i].first == index; ++i)
+                scalar += terms[i].second;
+            if (std::abs(scalar) >= 1e-10)
+                terms[n++] = { index, scalar };
+        }
+        terms.resize(n);
+    }
+
+    template <int d>
+    struct FlatPolynomial {
+        std::vector<std::pair<monIndex, double>> Terms;
+
+        FlatPolynomial() = default;
+        FlatPolynomial(std::vector<std::pair<monIndex, double>> terms) : Terms(std::move(terms)) { _SortAndCombine(Terms); }
+        template<typename Map>
+        explicit FlatPolynomial(const Polynomial<d, Map>& p) : Terms(p.Terms.begin(), p.Terms.end()) { _SortAndCombine(Terms); }
+
+        monOrder Order() const {
+            return Poly<d>::MonOrder(Terms.empty() ? -1 : Terms.back().first);
+        }
+        double Coefficient(const monIndex alpha) const {
+            const auto it = std::lower_bound(Terms.begin(), Terms.end(), alpha, [](const std::pair<monIndex, double>& term, const monIndex index) { return term.first < index; });
+            return (it != Terms.end() && it->first == alpha ? it->second : 0.0);
+        }
+        Polynomial<d> ToSparse() const {
+            Polynomial<d> result;
+            result.Terms.reserve(Terms.size());
+            for (const auto& it : Terms)
+                result.Terms[it.first] = it.second;
+            return result;
+        }
+
+        FlatPolynomial<d>& operator*=(const FlatPolynomial<d>& p);
+        FlatPolynomial<d>& operator+=(const FlatPolynomial<d>& p);
+        void CheckZeroes() {
+            Terms.erase(std::remove_if(Terms.begin(), Terms.end(), [](const std::pair<monIndex, double>& term) { return std::abs(term.second) < 1e-10; }), Terms.end());
+        }
+    };
+
+    template<int d>
+    FlatPolynomial<d> operator+(const FlatPolynomial<d>& p1, const FlatPolynomial<d>& p2) {
+        FlatPolynomial<d> result;
+        result.Terms.reserve(p1.Terms.size() + p2.Terms.size());
+        auto it1 = p1.Terms.begin(), it2 = p2.Terms.begin();
+        while (it1 != p1.Terms.end() && it2 != p2.Terms.end()) {
+            if (it1->first < it2->first)
+                result.Terms.push_back(*it1++);
+            else if (it2->first < it1->first)
+                result.Terms.push_back(*it2++);
+            else {
+                const double scalar = (it1++)->second + (it2++)->second;
+                if (std::abs(scalar) >= 1e-10)
+                    result.Terms.emplace_back(std::prev(it1)->first, scalar);
+            }
+        }
+        result.Terms.insert(result.Terms.end(), it1, p1.Terms.end());
+        result.Terms.insert(result.Terms.end(), it2, p2.Terms.end());
+        return result;
+    }
+
+    template<int d>
+    FlatPolynomial<d> operator*(const FlatPolynomial<d>& p1, const FlatPolynomial<d>& p2) {
+        FlatPolynomial<d> result;
+        result.Terms.reserve(p1.Terms.size() * p2.Terms.size());
+        for (const auto& it1 : p1.Terms)
+            for (const auto& it2 : p2.Terms)
+                result.Terms.emplace_back(Poly<d>::Product(it1.first, it2.first), it1.second * it2.second);
+        _SortAndCombine(result.Terms);
+        return result;
+    }
+
+    template<int d, monOrder K>
+    FlatPolynomial<d> Multiply(const FlatPolynomial<d>& p1, const FlatPolynomial<d>& p2, const ProductTable<d, K>& table) {
+        FlatPolynomial<d> result;
+        result.Terms.reserve(p1.Terms.size() * p2.Terms.size());
+        for (const auto& it1 : p1.Terms)
+            for (const auto& it2 : p2.Terms)
+                result.Terms.emplace_back(table.Product(it1.first, it2.first), it1.second * it2.second);
+        _SortAndCombine(result.Terms);
+        return result;
+    }
+
+    /*
+        Part of p1 * p2 up to order K, the sorted terms allowing both loops to stop at the first term out of reach.
+    */
+    template<int d>
+    FlatPolynomial<d> MultiplyTruncated(const FlatPolynomial<d>& p1, const FlatPolynomial<d>& p2, const monOrder K) {
+        FlatPolynomial<d> result;
+        const monIndex bound1 = Poly<d>::SpaceDim(K);
+        for (const auto& it1 : p1.Terms) {
+            if (it1.first >= bound1)
+                break;
+            const monIndex bound2 = Poly<d>::SpaceDim(K - Poly<d>::MonOrder(it1.first));
+            for (const auto& it2 : p2.Terms) {
+                if (it2.first >= bound2)
+                    break;
+                result.Terms.emplace_back(Poly<d>::Product(it1.first, it2.first), it1.second * it2.second);
+            }
+        }
+        _SortAndCombine(result.Terms);
+        return result;
+    }
+
+    template<int d>
+    FlatPolynomial<d>& FlatPolynomial<d>::operator*=(const FlatPolynomial<d>& p) {
+        Terms = std::move((*this * p).Terms);
+        return *this;
+    }
+    template<int d>
+    FlatPolynomial<d>& FlatPolynomial<d>::operator+=(const FlatPolynomial<d>& p) {
+        Terms = std::move((*this + p).Terms);
+        return *this;
+    }
+
+    /*
+        Polynomials allocating their terms from a std::pmr::memory_resource, e.g., a pool or monotonic buffer reused across elements:
+            std::pmr::unsynchronized_pool_resource pool;
+            mnl::PmrPolynomial<d> p(&pool);
+    */
+    template<int d>
+    using PmrPolynomial = Polynomial<d, std::pmr::unordered_map<monIndex, double>>;
+
 #define ALIASpnl(d) using pnl ##d ##D = Polynomial<d>
     ALIASpnl(1);
     ALIASpnl(2);
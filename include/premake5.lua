@@ -2,7 +2,7 @@ project "mnl"
 	location "../build"
 	kind "StaticLib"
 	language "C++"
-	cppdialect "C++11"
+	cppdialect "C++17"
 
 	targetdir ("build/bin/" .. outputdir .. "%{prj.name}")
 	objdir ("build/bin-int/" .. outputdir .. "%{prj.name}")
@@ -12,11 +12,14 @@ project "mnl"
 		"**.h",
 		"**.hpp",
 		"**.cpp",
+		-- Compile-only check that every header builds as C++17
+		"../tests/cpp17/**.cpp",
 	}
 
 	includedirs
 	{
 		"include",
+		".",
 	}
 
 	filter "configurations:Debug"
@@ -0,0 +1,233 @@
+/**********************************************************************************************************************************
+                                            Monomial's Library by Tiago Fernandes Moherdaui
+
+            The library is meant to make operations with monomials easier by use of indicial notation.
+
+            This file provides multithreaded versions of the operations on dense polynomials of high order.
+
+                Product using nThreads threads                  p3 = mnl::MultiplyParallel(p1, p2, nThreads);
+
+            The product is partitioned by the order of the monomials of the result: the monomials of order n of p1*p2 only
+            receive products of monomials of orders n1 and n - n1, so each thread computes a range of orders of the result,
+            writing to its own range of indices, with no atomics nor locks. The ranges are chosen so that each thread
+            computes about the same number of products of monomials.
+
+            Threads are started on the first call and kept in a pool, so later calls only wake them. A call made while another
+            thread uses the pool starts threads of its own instead of waiting for it, and a call made from within a task of the
+            pool runs in that thread. When compiled with OpenMP (e.g., -fopenmp, option MNL_OPENMP in CMake), its threads are
+            used instead, nThreads of them.
+
+            This is produced in C++17 and includes only <algorithm>, <condition_variable>, <exception>, <functional>, <mutex>, <thread> and <vector>.
+
+**********************************************************************************************************************************/
+#pragma once
+#ifndef PRL
+#define PRL
+#include "dnl.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mnl {
+    /*
+        Calls task(i), returning the exception it throws, if any, so that the threads running the other tasks can be waited for.
+    */
+    template<typename Task>
+    std::exception_ptr _TryTask(const Task& task, const int i) noexcept {
+        try {
+            task(i);
+        }
+        catch (...) {
+            return std::current_exception();
+        }
+        return nullptr;
+    }
+
+    /************************************************************
+        Threads kept alive between calls, started on demand.
+        Run(nTasks, task) calls task(i) for i in [0, nTasks), task(0)
+        in the calling thread and the others in the workers, and
+        returns once all of them are done, rethrowing the first
+        exception thrown by a task. A call from within a task runs
+        its tasks in that thread, one after the other, and a call
+        while another thread uses the pool runs them in threads of
+        its own, started for that call.
+    ************************************************************/
+    class _ThreadPool {
+    public:
+        static _ThreadPool& Instance() {
+            static _ThreadPool pool;
+            return pool;
+        }
+        ~_ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _wake.notify_all();
+            for (std::thread& worker : _workers)
+                worker.join();
+        }
+
+        template<typename Task>
+        void Run(const int nTasks, const Task& task) {
+            if (_inTask) {
+                for (int i = 0; i < nTasks; ++i)
+                    task(i);
+                return;
+            }
+            std::unique_lock<std::mutex> run(_runMutex, std::try_to_lock);
+            if (!run.owns_lock()) {
+                _RunDetached(nTasks, task);
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                while ((int)_workers.size() < nTasks - 1)
+                    _workers.emplace_back([this]() { _Work(); });
+                _task = [&task](const int i) { task(i); };
+                _error = nullptr;
+                _next = 1;
+                _nTasks = nTasks;
+                _pending = nTasks - 1;
+            }
+            _wake.notify_all();
+            std::exception_ptr error = nTasks > 0 ? _RunTask(task, 0) : nullptr;
+            // The workers reference task until all of them are done
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this]() { return _pending <= 0; });
+            if (!error)
+                error = _error;
+            _task = nullptr;
+            _error = nullptr;
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+    private:
+        _ThreadPool() = default;
+
+        template<typename Task>
+        static std::exception_ptr _RunTask(const Task& task, const int i) {
+            _inTask = true;
+            std::exception_ptr error = _TryTask(task, i);
+            _inTask = false;
+            return error;
+        }
+
+        template<typename Task>
+        static void _RunDetached(const int nTasks, const Task& task) {
+            std::vector<std::exception_ptr> errors(std::max(nTasks, 0));
+            std::vector<std::thread> threads;
+            for (int i = 1; i < nTasks; ++i)
+                threads.emplace_back([&task, &errors, i]() { errors[i] = _RunTask(task, i); });
+            if (nTasks > 0)
+                errors[0] = _RunTask(task, 0);
+            for (std::thread& thread : threads)
+                thread.join();
+            for (const std::exception_ptr& error : errors)
+                if (error)
+                    std::rethrow_exception(error);
+        }
+
+        void _Work() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true) {
+                _wake.wait(lock, [this]() { return _stop || _next < _nTasks; });
+                if (_stop)
+                    return;
+                const int i = _next++;
+                lock.unlock();
+                const std::exception_ptr error = _RunTask(_task, i);
+                lock.lock();
+                if (error && !_error)
+                    _error = error;
+                if (--_pending == 0)
+                    _done.notify_one();
+            }
+        }
+
+        static inline thread_local bool _inTask = false;
+        std::vector<std::thread> _workers;
+        std::function<void(int)> _task;
+        std::exception_ptr _error;
+        std::mutex _runMutex, _mutex;
+        std::condition_variable _wake, _done;
+        int _next = 0, _nTasks = 0, _pending = 0;
+        bool _stop = false;
+    };
+
+    /*
+        Calls task(i) for i in [0, nTasks), each in its own thread (OpenMP's when enabled, the ones of _ThreadPool otherwise),
+        rethrowing the first exception thrown by a task once all of them are done.
+    */
+    template<typename Task>
+    void _ParallelFor(const int nTasks, const Task& task) {
+#if defined(_OPENMP)
+        // An exception must not leave the parallel region
+        std::vector<std::exception_ptr> errors(std::max(nTasks, 0));
+#pragma omp parallel for schedule(static, 1) num_threads(nTasks)
+        for (int i = 0; i < nTasks; ++i)
+            errors[i] = _TryTask(task, i);
+        for (const std::exception_ptr& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+#else
+        _ThreadPool::Instance().Run(nTasks, task);
+#endif
+    }
+
+    /************************************************************
+        Product of dense polynomials, the orders of the result
+        being split in nThreads ranges of about the same work
+        (nThreads = 0 uses std::thread::hardware_concurrency()).
+    ************************************************************/
+    template<int d>
+    DensePolynomial<d> MultiplyParallel(const DensePolynomial<d>& p1, const DensePolynomial<d>& p2, int nThreads = 0) {
+        if (p1.Coefficients.empty() || p2.Coefficients.empty())
+            return DensePolynomial<d>();
+        const monOrder k1 = p1.Order(), k2 = p2.Order(), k = k1 + k2;
+        DensePolynomial<d> result(k);
+
+        // Products of monomials landing on each order of the result
+        std::vector<double> work(k + 2, 0.0);
+        for (monOrder n = 0; n <= k; ++n)
+            for (monOrder n1 = std::max(0, n - k2); n1 <= std::min(k1, n); ++n1)
+                work[n + 1] += (double)_OrderDim(d, n1) * (double)_OrderDim(d, n - n1);
+        for (monOrder n = 0; n <= k; ++n)
+            work[n + 1] += work[n];
+
+        if (nThreads <= 0)
+            nThreads = std::max(1, (int)std::thread::hardware_concurrency());
+        nThreads = std::min(nThreads, k + 1);
+        // Orders [first[t], first[t + 1]) for thread t
+        std::vector<monOrder> first(nThreads + 1, k + 1);
+        first[0] = 0;
+        for (int t = 1; t < nThreads; ++t) {
+            const double target = work[k + 1] * t / nThreads;
+            // work[i] is the work of the orders below i
+            first[t] = std::max(first[t - 1], (monOrder)(std::lower_bound(work.begin(), work.end(), target) - work.begin()));
+        }
+
+        _ParallelFor(nThreads, [&](const int t) {
+            for (monOrder n = first[t]; n < first[t + 1]; ++n) {
+                for (monOrder n1 = std::max(0, n - k2); n1 <= std::min(k1, n); ++n1) {
+                    const monIndex beta0 = Poly<d>::SpaceDim(n - n1 - 1), beta1 = Poly<d>::SpaceDim(n - n1);
+                    for (monIndex alpha = Poly<d>::SpaceDim(n1 - 1); alpha < Poly<d>::SpaceDim(n1); ++alpha) {
+                        const double c1 = p1.Coefficients[alpha];
+                        if (c1 == 0.0)
+                            continue;
+                        for (monIndex beta = beta0; beta < beta1; ++beta)
+                            result.Coefficients[Poly<d>::Product(alpha, beta)] += c1 * p2.Coefficients[beta];
+                    }
+                }
+            }
+        });
+        return result;
+    }
+}
+#endif
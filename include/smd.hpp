@@ -0,0 +1,85 @@
+/**********************************************************************************************************************************
+                                            Monomial's Library by Tiago Fernandes Moherdaui
+
+            The library is meant to make operations with monomials easier by use of indicial notation.
+
+            This file provides the element-wise kernels over contiguous arrays of doubles used by the batched operations.
+            They use AVX-512 or AVX2 when the compiler targets them (e.g., -mavx512f or -mavx2 -mfma, /arch:AVX2),
+            with a scalar fallback for the remaining elements and for other targets.
+
+                dst[i] = a[i] * b[i]                            mnl::_VecMul(dst, a, b, n);
+                dst[i] += a[i] * b[i]                           mnl::_VecFma(dst, a, b, n);
+                dst[i] += a * x[i]                              mnl::_VecAxpy(dst, a, x, n);
+
+            This is produced in C++17 and includes only <cstddef> and, when targeting AVX, <immintrin.h>.
+
+**********************************************************************************************************************************/
+#pragma once
+#ifndef SMD
+#define SMD
+#include <cstddef>
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace mnl {
+    /*
+        Number of doubles in a vector register of the target, the step of the vector loops of the kernels.
+    */
+#if defined(__AVX512F__)
+    constexpr size_t _simdWidth = 8;
+#elif defined(__AVX2__)
+    constexpr size_t _simdWidth = 4;
+#else
+    constexpr size_t _simdWidth = 1;
+#endif
+
+    inline void _VecMul(double* dst, const double* a, const double* b, const size_t n) {
+        size_t i = 0;
+#if defined(__AVX512F__)
+        for (; i + _simdWidth <= n; i += _simdWidth)
+            _mm512_storeu_pd(dst + i, _mm512_mul_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+#elif defined(__AVX2__)
+        for (; i + _simdWidth <= n; i += _simdWidth)
+            _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+#endif
+        for (; i < n; ++i)
+            dst[i] = a[i] * b[i];
+    }
+
+    inline void _VecFma(double* dst, const double* a, const double* b, const size_t n) {
+        size_t i = 0;
+#if defined(__AVX512F__)
+        for (; i + _simdWidth <= n; i += _simdWidth)
+            _mm512_storeu_pd(dst + i, _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), _mm512_loadu_pd(dst + i)));
+#elif defined(__AVX2__) && defined(__FMA__)
+        for (; i + _simdWidth <= n; i += _simdWidth)
+            _mm256_storeu_pd(dst + i, _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), _mm256_loadu_pd(dst + i)));
+#elif defined(__AVX2__)
+        for (; i + _simdWidth <= n; i += _simdWidth)
+            _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)), _mm256_loadu_pd(dst + i)));
+#endif
+        for (; i < n; ++i)
+            dst[i] += a[i] * b[i];
+    }
+
+    inline void _VecAxpy(double* dst, const double a, const double* x, const size_t n) {
+        size_t i = 0;
+#if defined(__AVX512F__)
+        const __m512d va = _mm512_set1_pd(a);
+        for (; i + _simdWidth <= n; i += _simdWidth)
+            _mm512_storeu_pd(dst + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), _mm512_loadu_pd(dst + i)));
+#elif defined(__AVX2__) && defined(__FMA__)
+        const __m256d va = _mm256_set1_pd(a);
+        for (; i + _simdWidth <= n; i += _simdWidth)
+            _mm256_storeu_pd(dst + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(dst + i)));
+#elif defined(__AVX2__)
+        const __m256d va = _mm256_set1_pd(a);
+        for (; i + _simdWidth <= n; i += _simdWidth)
+            _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_mul_pd(va, _mm256_loadu_pd(x + i)), _mm256_loadu_pd(dst + i)));
+#endif
+        for (; i < n; ++i)
+            dst[i] += a * x[i];
+    }
+}
+#endif
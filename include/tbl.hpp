@@ -0,0 +1,253 @@
+/**********************************************************************************************************************************
+                                            Monomial's Library by Tiago Fernandes Moherdaui
+
+            The library is meant to make operations with monomials easier by use of indicial notation.
+
+            This file provides lookup tables for operations over all monomials up to a bounded order K, i.e., in P_K(R^d).
+            They are meant for loops over pairs of monomials, e.g., when building Gram and mass matrices.
+
+                Table of products of monomials in P_K(R^d)      mnl::ProductTable<d, K> table;
+                Index of Product (table lookup)                 table.Product(alpha, beta);
+                Products of alpha with beta >= alpha            table.Row(alpha)[beta];
+
+            Products are symmetric, so only pairs with alpha <= beta are stored, row by row (upper triangle).
+            Each row is contiguous, and loops with beta >= alpha running over it are cache-friendly.
+
+            Derivatives and antiderivatives of monomials in P_K(R^d), with their coefficients, are built at compile time:
+
+                Table of derivatives                            constexpr mnl::DerivativeTable<d, K> table;
+                d/dx_i(m_alpha) = c m_beta                      beta = table.Target(alpha, i); c = table.Coefficient(alpha, i);
+                Table of antiderivatives                        constexpr mnl::AntiderivativeTable<d, K> table;
+                m_alpha = c d/dx_i(m_beta)                      beta = table.Target(alpha, i); c = table.Coefficient(alpha, i);
+
+            These tables also provide sparse matrices (CSR) acting on the coefficients of polynomials, ordered by the monomial
+            indices, i.e., a polynomial in P_K(R^d) is the vector of its SpaceDim(K) coefficients:
+
+                d/dx_i: P_K -> P_(K-1)                          table.Operator(i);
+                Gradient: P_K -> P_(K-1)^d                      table.Gradient();
+                Divergence: P_K^d -> P_(K-1)                    table.Divergence();
+                Laplacian: P_K -> P_(K-2)                       table.Laplacian();
+                Antiderivative in x_i: P_K -> P_(K+1)           table.Operator(i);
+
+            Vector fields in P_K^d are stacked by component, i.e., coefficient alpha of component j is at j * SpaceDim(K) + alpha.
+
+            This is produced in C++17 and includes only <array> and <vector>.
+
+**********************************************************************************************************************************/
+#pragma once
+#ifndef TBL
+#define TBL
+#include "mnl.hpp"
+#include <vector>
+
+namespace mnl {
+    template<const int d, const monOrder K>
+    class ProductTable {
+    public:
+        static constexpr monIndex Size = Poly<d>::SpaceDim(K);
+
+        ProductTable() : _products(((size_t)Size * (size_t)(Size + 1)) / 2) {
+            for (monIndex alpha = 0; alpha < Size; ++alpha) {
+                monIndex* row = _products.data() + _RowOffset(alpha) - alpha;
+                for (monIndex beta = alpha; beta < Size; ++beta)
+                    row[beta] = Poly<d>::Product(alpha, beta);
+            }
+        }
+
+        /************************************************************
+            Product of monomials alpha and beta.
+            Indices outside the table fall back to the recursion.
+        ************************************************************/
+        monIndex Product(monIndex alpha, monIndex beta) const {
+            if (alpha == -1 || beta == -1)
+                return -1;
+            if (alpha > beta) {
+                const monIndex aux = alpha;
+                alpha = beta;
+                beta = aux;
+            }
+            if (beta >= Size)
+                return Poly<d>::Product(alpha, beta);
+            return _products[_RowOffset(alpha) + (size_t)(beta - alpha)];
+        }
+
+        /************************************************************
+            Products of alpha with every beta in [alpha, Size),
+            accessed as Row(alpha)[beta].
+        ************************************************************/
+        const monIndex* Row(const monIndex alpha) const {
+            return _products.data() + _RowOffset(alpha) - alpha;
+        }
+
+    private:
+        std::vector<monIndex> _products;
+
+        static constexpr size_t _RowOffset(const monIndex alpha) {
+            return (size_t)alpha * (size_t)Size - ((size_t)alpha * (size_t)(alpha - 1)) / 2;
+        }
+    };
+
+    /************************************************************
+        Sparse matrix in compressed sparse row format.
+        Entries of row r are in [RowStart[r], RowStart[r + 1]).
+    ************************************************************/
+    struct CSRMatrix {
+        monIndex                Rows = 0;
+        monIndex                Cols = 0;
+        std::vector<size_t>     RowStart;
+        std::vector<monIndex>   Columns;
+        std::vector<double>     Values;
+
+        /*
+            y = A x, x of size Cols and y of size Rows.
+        */
+        void Multiply(const double* x, double* y) const {
+            for (monIndex r = 0; r < Rows; ++r) {
+                double sum = 0.0;
+                for (size_t it = RowStart[r]; it < RowStart[r + 1]; ++it)
+                    sum += Values[it] * x[Columns[it]];
+                y[r] = sum;
+            }
+        }
+    };
+
+    struct _CSREntry {
+        monIndex row;
+        monIndex col;
+        double value;
+    };
+
+    inline CSRMatrix _BuildCSR(const monIndex rows, const monIndex cols, const std::vector<_CSREntry>& entries) {
+        CSRMatrix A;
+        A.Rows = rows;
+        A.Cols = cols;
+        A.RowStart.assign((size_t)rows + 1, 0);
+        for (const _CSREntry& entry : entries)
+            ++A.RowStart[(size_t)entry.row + 1];
+        for (monIndex r = 0; r < rows; ++r)
+            A.RowStart[(size_t)r + 1] += A.RowStart[r];
+        A.Columns.resize(entries.size());
+        A.Values.resize(entries.size());
+        std::vector<size_t> next(A.RowStart.begin(), A.RowStart.end() - 1);
+        for (const _CSREntry& entry : entries) {
+            const size_t it = next[entry.row]++;
+            A.Columns[it] = entry.col;
+            A.Values[it] = entry.value;
+        }
+        return A;
+    }
+
+    /************************************************************
+        Derivatives of all monomials in P_K(R^d):
+        d/dx_i(m_alpha) = Coefficients[i][alpha] m_(Targets[i][alpha]).
+        Targets are -1 (and coefficients 0) where the derivative vanishes.
+    ************************************************************/
+    template<const int d, const monOrder K>
+    struct DerivativeTable {
+        static constexpr monIndex Size = Poly<d>::SpaceDim(K);
+
+        std::array<std::array<monIndex, Size>, d> Targets{};
+        std::array<std::array<int, Size>, d> Coefficients{};
+
+        constexpr DerivativeTable() {
+            for (monIndex alpha = 0; alpha < Size; ++alpha) {
+                const std::array<int, d> e = Poly<d>::Exponents(alpha);
+                for (int i = 0; i < d; ++i) {
+                    Targets[i][alpha] = Poly<d>::D(alpha, i);
+                    Coefficients[i][alpha] = e[i];
+                }
+            }
+        }
+
+        constexpr monIndex  Target(const monIndex alpha, const int variable) const { return Targets[variable][alpha]; }
+        constexpr int       Coefficient(const monIndex alpha, const int variable) const { return Coefficients[variable][alpha]; }
+
+        /************************************************************
+            d/dx_variable: P_K -> P_(K-1).
+        ************************************************************/
+        CSRMatrix Operator(const int variable) const {
+            std::vector<_CSREntry> entries;
+            for (monIndex alpha = 0; alpha < Size; ++alpha)
+                if (Targets[variable][alpha] != -1)
+                    entries.push_back({ Targets[variable][alpha], alpha, (double)Coefficients[variable][alpha] });
+            return _BuildCSR(Poly<d>::SpaceDim(K - 1), Size, entries);
+        }
+
+        /************************************************************
+            Gradient: P_K -> P_(K-1)^d, stacked by component.
+        ************************************************************/
+        CSRMatrix Gradient() const {
+            const monIndex nTarget = Poly<d>::SpaceDim(K - 1);
+            std::vector<_CSREntry> entries;
+            for (int j = 0; j < d; ++j)
+                for (monIndex alpha = 0; alpha < Size; ++alpha)
+                    if (Targets[j][alpha] != -1)
+                        entries.push_back({ j * nTarget + Targets[j][alpha], alpha, (double)Coefficients[j][alpha] });
+            return _BuildCSR(d * nTarget, Size, entries);
+        }
+
+        /************************************************************
+            Divergence: P_K^d -> P_(K-1), stacked by component.
+        ************************************************************/
+        CSRMatrix Divergence() const {
+            std::vector<_CSREntry> entries;
+            for (int j = 0; j < d; ++j)
+                for (monIndex alpha = 0; alpha < Size; ++alpha)
+                    if (Targets[j][alpha] != -1)
+                        entries.push_back({ Targets[j][alpha], j * Size + alpha, (double)Coefficients[j][alpha] });
+            return _BuildCSR(Poly<d>::SpaceDim(K - 1), d * Size, entries);
+        }
+
+        /************************************************************
+            Laplacian: P_K -> P_(K-2).
+        ************************************************************/
+        CSRMatrix Laplacian() const {
+            std::vector<_CSREntry> entries;
+            for (int j = 0; j < d; ++j) {
+                for (monIndex alpha = 0; alpha < Size; ++alpha) {
+                    const monIndex beta = Targets[j][alpha];
+                    if (beta != -1 && Targets[j][beta] != -1)
+                        entries.push_back({ Targets[j][beta], alpha, (double)(Coefficients[j][alpha] * Coefficients[j][beta]) });
+                }
+            }
+            return _BuildCSR(Poly<d>::SpaceDim(K - 2), Size, entries);
+        }
+    };
+
+    /************************************************************
+        Antiderivatives of all monomials in P_K(R^d):
+        m_alpha = Coefficients[i][alpha] d/dx_i(m_(Targets[i][alpha])),
+        i.e., Coefficients[i][alpha] = 1 / (exponent of x_i + 1).
+    ************************************************************/
+    template<const int d, const monOrder K>
+    struct AntiderivativeTable {
+        static constexpr monIndex Size = Poly<d>::SpaceDim(K);
+
+        std::array<std::array<monIndex, Size>, d> Targets{};
+        std::array<std::array<double, Size>, d> Coefficients{};
+
+        constexpr AntiderivativeTable() {
+            for (monIndex alpha = 0; alpha < Size; ++alpha) {
+                const std::array<int, d> e = Poly<d>::Exponents(alpha);
+                for (int i = 0; i < d; ++i) {
+                    Targets[i][alpha] = Poly<d>::AD(alpha, i);
+                    Coefficients[i][alpha] = 1.0 / (double)(e[i] + 1);
+                }
+            }
+        }
+
+        constexpr monIndex  Target(const monIndex alpha, const int variable) const { return Targets[variable][alpha]; }
+        constexpr double    Coefficient(const monIndex alpha, const int variable) const { return Coefficients[variable][alpha]; }
+
+        /************************************************************
+            Antiderivative in x_variable: P_K -> P_(K+1).
+        ************************************************************/
+        CSRMatrix Operator(const int variable) const {
+            std::vector<_CSREntry> entries;
+            for (monIndex alpha = 0; alpha < Size; ++alpha)
+                entries.push_back({ Targets[variable][alpha], alpha, Coefficients[variable][alpha] });
+            return _BuildCSR(Poly<d>::SpaceDim(K + 1), Size, entries);
+        }
+    };
+}
+#endif
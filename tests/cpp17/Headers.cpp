@@ -0,0 +1,12 @@
+// Compile-only check that every header of the library builds as C++17, the tests being C++23
+#include "mnl.hpp"
+#include "pnl.hpp"
+#include "glq.hpp"
+#include "gtq.hpp"
+#include "tbl.hpp"
+#include "evl.hpp"
+#include "smd.hpp"
+#include "itg.hpp"
+#include "dnl.hpp"
+#include "hmp.hpp"
+#include "prl.hpp"
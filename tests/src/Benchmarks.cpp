@@ -0,0 +1,403 @@
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <tuple>
+#include "catch_amalgamated.hpp"
+
+#include "mnl.hpp"
+#include "gtq.hpp"
+#include "itg.hpp"
+#include "pnl.hpp"
+#include "dnl.hpp"
+#include "prl.hpp"
+
+using namespace mnl;
+
+/*
+	Benchmarks are hidden from the default run, to execute them:
+	tests "[benchmark]"
+*/
+
+template<const int d, const monOrder K>
+void MonomialTableBenchmark() {
+	static constexpr MonomialTable<d, K> table;
+	const std::string name = std::to_string(d) + "D, K = " + std::to_string(K);
+
+	BENCHMARK("Recursive " + name) {
+		int sum = 0;
+		for (monIndex alpha = 0; alpha < table.Size; ++alpha) {
+			sum += Poly<d>::MonOrder(alpha);
+			for (int x = 0; x < d; ++x)
+				sum += Poly<d>::Exponent(alpha, x);
+		}
+		return sum;
+	};
+	BENCHMARK("Table " + name) {
+		int sum = 0;
+		for (monIndex alpha = 0; alpha < table.Size; ++alpha) {
+			sum += Poly<d>::MonOrder(alpha, table);
+			for (int x = 0; x < d; ++x)
+				sum += Poly<d>::Exponent(alpha, x, table);
+		}
+		return sum;
+	};
+}
+
+TEST_CASE("Monomial Table Benchmark", "[.][benchmark]") {
+	MonomialTableBenchmark<2, 5>();
+	MonomialTableBenchmark<2, 10>();
+	MonomialTableBenchmark<2, 20>();
+	MonomialTableBenchmark<3, 5>();
+	MonomialTableBenchmark<3, 10>();
+	MonomialTableBenchmark<3, 20>();
+}
+
+/*
+	Previous floating-point estimate of the order, corrected with a linear search.
+*/
+template<const int d>
+monOrder FloatingPointMonOrder(const monIndex alpha) {
+	monOrder k = std::max(0, (int)ceil(pow((double)(Factorial(d) * (alpha + 1)), 1.0 / d) - d));
+	while (alpha >= Poly<d>::SpaceDim(k))
+		++k;
+	return k;
+}
+
+template<const int d>
+void MonOrderBenchmark(const monOrder K) {
+	const monIndex n = Poly<d>::SpaceDim(K);
+	const std::string name = std::to_string(d) + "D, K = " + std::to_string(K);
+
+	BENCHMARK("Floating-point MonOrder " + name) {
+		int sum = 0;
+		for (monIndex alpha = 0; alpha < n; ++alpha)
+			sum += FloatingPointMonOrder<d>(alpha);
+		return sum;
+	};
+	BENCHMARK("Integer MonOrder " + name) {
+		int sum = 0;
+		for (monIndex alpha = 0; alpha < n; ++alpha)
+			sum += Poly<d>::MonOrder(alpha);
+		return sum;
+	};
+}
+
+TEST_CASE("MonOrder Benchmark", "[.][benchmark]") {
+	MonOrderBenchmark<2>(20);
+	MonOrderBenchmark<3>(20);
+	MonOrderBenchmark<6>(10);
+}
+
+/*
+	Polygon integration: sub-triangulation from the centroid with triangle quadratures against HNI.
+*/
+void PolygonIntegrationBenchmark(const monOrder K) {
+	std::vector<std::array<double, 2>> hexagon;
+	for (int v = 0; v < 6; ++v)
+		hexagon.push_back({ 0.5 * cos(v * M_PI / 3.0), 0.5 * sin(v * M_PI / 3.0) });
+	const std::vector<std::array<double, 3>> rule = GaussLegendreTriangle(K);
+	const std::string name = "hexagon, K = " + std::to_string(K);
+
+	BENCHMARK("Triangulation " + name) {
+		std::vector<double> integrals(Poly<2>::SpaceDim(K), 0.0), values(integrals.size());
+		for (size_t v = 0; v < hexagon.size(); ++v) {
+			const std::array<double, 2>& a = hexagon[v];
+			const std::array<double, 2>& b = hexagon[(v + 1) % hexagon.size()];
+			const double area = 0.5 * (a[0] * b[1] - a[1] * b[0]);
+			for (const auto& q : rule) {
+				const double x[2] = { q[0] * a[0] + q[1] * b[0], q[0] * a[1] + q[1] * b[1] };
+				EvaluateBasis<2>(x, K, values.data());
+				for (size_t alpha = 0; alpha < values.size(); ++alpha)
+					integrals[alpha] += area * q[2] * values[alpha];
+			}
+		}
+		return integrals;
+	};
+	BENCHMARK("HNI " + name) {
+		return IntegratePolygonMonomials(hexagon, K);
+	};
+}
+
+TEST_CASE("Polygon Integration Benchmark", "[.][benchmark]") {
+	PolygonIntegrationBenchmark(5);
+	PolygonIntegrationBenchmark(10);
+	PolygonIntegrationBenchmark(14);
+}
+
+/*
+	Sparse polynomials: hash map against sorted flat storage, for polynomials with every third monomial up to order K.
+*/
+template<const int d>
+void SparsePolynomialBenchmark(const monOrder K) {
+	Polynomial<d> p;
+	for (monIndex alpha = 0; alpha < Poly<d>::SpaceDim(K); alpha += 3)
+		p.Terms[alpha] = 1.0 / (alpha + 1.0);
+	const FlatPolynomial<d> f(p);
+	const std::string name = std::to_string(d) + "D, K = " + std::to_string(K);
+
+	BENCHMARK("Polynomial product " + name) {
+		return p * p;
+	};
+	BENCHMARK("FlatPolynomial product " + name) {
+		return f * f;
+	};
+	BENCHMARK("Polynomial sum " + name) {
+		Polynomial<d> q = p;
+		q += p;
+		return q;
+	};
+	BENCHMARK("FlatPolynomial sum " + name) {
+		return f + f;
+	};
+}
+
+TEST_CASE("Sparse Polynomial Benchmark", "[.][benchmark]") {
+	SparsePolynomialBenchmark<2>(10);
+	SparsePolynomialBenchmark<3>(8);
+}
+
+/*
+	Polynomial<d> with std::unordered_map against OpenHashMap, for products of full polynomials of order K/2.
+*/
+template<const int d, typename Map>
+void PolynomialBackendBenchmark(const std::string& backend, const monOrder K) {
+	Polynomial<d, Map> p;
+	for (monIndex alpha = 0; alpha < Poly<d>::SpaceDim(K / 2); ++alpha)
+		p.Terms[alpha] = 1.0 / (alpha + 1.0);
+	const Polynomial<d, Map> q = p * p;
+	const std::string name = backend + " " + std::to_string(d) + "D, K = " + std::to_string(K);
+
+	BENCHMARK("Product " + name) {
+		return p * p;
+	};
+	BENCHMARK("Sum " + name) {
+		Polynomial<d, Map> r = q;
+		r += q;
+		return r;
+	};
+}
+
+template<const int d>
+void PolynomialBackendBenchmark(const monOrder K) {
+	PolynomialBackendBenchmark<d, std::unordered_map<monIndex, double>>("unordered_map", K);
+	PolynomialBackendBenchmark<d, OpenHashMap<monIndex, double>>("OpenHashMap", K);
+}
+
+TEST_CASE("Polynomial Backend Benchmark", "[.][benchmark]") {
+	PolynomialBackendBenchmark<2>(5);
+	PolynomialBackendBenchmark<2>(10);
+	PolynomialBackendBenchmark<2>(20);
+	PolynomialBackendBenchmark<3>(5);
+	PolynomialBackendBenchmark<3>(10);
+	PolynomialBackendBenchmark<3>(20);
+}
+
+/*
+	Products of full polynomials of order K against their parts up to order K, as when projecting into P_K.
+*/
+template<const int d>
+void TruncatedProductBenchmark(const monOrder K) {
+	DensePolynomial<d> p(K);
+	for (size_t alpha = 0; alpha < p.Coefficients.size(); ++alpha)
+		p.Coefficients[alpha] = 1.0 / (alpha + 1.0);
+	const Polynomial<d> sparse = p.ToSparse();
+	const std::string name = std::to_string(d) + "D, K = " + std::to_string(K);
+
+	BENCHMARK("Dense product " + name) {
+		return p * p;
+	};
+	BENCHMARK("Dense truncated product " + name) {
+		return MultiplyTruncated(p, p, K);
+	};
+	BENCHMARK("Sparse product " + name) {
+		return sparse * sparse;
+	};
+	BENCHMARK("Sparse truncated product " + name) {
+		return MultiplyTruncated(sparse, sparse, K);
+	};
+}
+
+TEST_CASE("Truncated Product Benchmark", "[.][benchmark]") {
+	TruncatedProductBenchmark<2>(10);
+	TruncatedProductBenchmark<3>(6);
+}
+
+/*
+	a*b + c*e evaluated eagerly, with a temporary per operator, against a single fused pass.
+*/
+template<const int d>
+void LazyExpressionBenchmark(const monOrder K) {
+	Polynomial<d> a, b, c, e;
+	for (monIndex alpha = 0; alpha < Poly<d>::SpaceDim(K); ++alpha) {
+		a.Terms[alpha] = 1.0 / (alpha + 1.0);
+		b.Terms[alpha] = 1.0 - alpha;
+		c.Terms[alpha] = 0.5 * alpha;
+		e.Terms[alpha] = 2.0;
+	}
+	const std::string name = std::to_string(d) + "D, K = " + std::to_string(K);
+
+	BENCHMARK("Eager a*b + c*e " + name) {
+		return a * b + c * e;
+	};
+	BENCHMARK("Lazy a*b + c*e " + name) {
+		Polynomial<d> result;
+		result = Lazy(a) * Lazy(b) + Lazy(c) * Lazy(e);
+		return result;
+	};
+}
+
+TEST_CASE("Lazy Expression Benchmark", "[.][benchmark]") {
+	LazyExpressionBenchmark<2>(5);
+	LazyExpressionBenchmark<2>(10);
+	LazyExpressionBenchmark<3>(5);
+}
+
+/*
+	Products of many pairs of dense polynomials of order K, one at a time against a batch following a product schedule.
+*/
+template<const int d>
+void BatchProductBenchmark(const monOrder K, const size_t count) {
+	std::vector<DensePolynomial<d>> polynomials(count, DensePolynomial<d>(K));
+	DensePolynomialBatch<d> batch(K, count), result;
+	for (size_t e = 0; e < count; ++e) {
+		for (size_t alpha = 0; alpha < polynomials[e].Coefficients.size(); ++alpha)
+			polynomials[e].Coefficients[alpha] = 1.0 / (alpha + e + 1.0);
+		batch.Set(e, polynomials[e]);
+	}
+	const ProductSchedule<d> schedule(K, K);
+	const std::string name = std::to_string(d) + "D, K = " + std::to_string(K) + ", " + std::to_string(count) + " elements";
+
+	BENCHMARK("One at a time " + name) {
+		double sum = 0.0;
+		for (size_t e = 0; e < count; ++e)
+			sum += (polynomials[e] * polynomials[e]).Coefficients.back();
+		return sum;
+	};
+	BENCHMARK("Batch " + name) {
+		MultiplyInto(result, batch, batch, schedule);
+		return result.Coefficients.back();
+	};
+}
+
+TEST_CASE("Batch Product Benchmark", "[.][benchmark]") {
+	BatchProductBenchmark<2>(2, 1000);
+	BatchProductBenchmark<2>(4, 1000);
+	BatchProductBenchmark<3>(2, 1000);
+}
+
+/*
+	Product of dense polynomials of order K/2 (result of order K), sequential against threaded.
+*/
+template<const int d>
+void ParallelProductBenchmark(const monOrder K) {
+	DensePolynomial<d> p(K / 2);
+	for (size_t alpha = 0; alpha < p.Coefficients.size(); ++alpha)
+		p.Coefficients[alpha] = 1.0 / (alpha + 1.0);
+	const std::string name = std::to_string(d) + "D, K = " + std::to_string(K);
+
+	BENCHMARK("Sequential " + name) {
+		return p * p;
+	};
+	for (const int nThreads : { 2, 4, 8 }) {
+		BENCHMARK("Parallel (" + std::to_string(nThreads) + " threads) " + name) {
+			return MultiplyParallel(p, p, nThreads);
+		};
+	}
+}
+
+TEST_CASE("Parallel Product Benchmark", "[.][benchmark]") {
+	ParallelProductBenchmark<3>(20);
+	ParallelProductBenchmark<3>(30);
+}
+
+/*
+	Values of a dense polynomial of order k and of a sparse one at nPoints points, evaluating the dense
+	polynomial point by point against the compiled program on batches of points.
+*/
+template<const int d>
+void CompiledPolynomialBenchmark(const monOrder k, const size_t nPoints) {
+	DensePolynomial<d> dense(k);
+	for (size_t alpha = 0; alpha < dense.Coefficients.size(); ++alpha)
+		dense.Coefficients[alpha] = 1.0 / (alpha + 1.0);
+	DensePolynomial<d> sparse(k);
+	for (size_t alpha = 0; alpha < sparse.Coefficients.size(); alpha += 17)
+		sparse.Coefficients[alpha] = 1.0 / (alpha + 1.0);
+	std::vector<double> points(d * nPoints), out(nPoints);
+	for (size_t p = 0; p < nPoints; ++p)
+		for (int i = 0; i < d; ++i)
+			points[i * nPoints + p] = 0.5 + 0.001 * (double)p - 0.1 * i;
+	const CompiledPolynomial<d> compiledDense(dense.Coefficients.data(), (monIndex)dense.Coefficients.size());
+	const CompiledPolynomial<d> compiledSparse(sparse.Coefficients.data(), (monIndex)sparse.Coefficients.size());
+	std::vector<double> workspace(std::max(compiledDense.WorkspaceSize(), compiledSparse.WorkspaceSize()));
+	const std::string name = std::to_string(d) + "D, k = " + std::to_string(k) + ", " + std::to_string(nPoints) + " points";
+
+	for (const auto& [label, p, compiled] : { std::tuple{ "dense", &dense, &compiledDense }, std::tuple{ "sparse", &sparse, &compiledSparse } }) {
+		BENCHMARK(std::string("Point by point, ") + label + ", " + name) {
+			std::array<double, d> x{};
+			for (size_t q = 0; q < nPoints; ++q) {
+				for (int i = 0; i < d; ++i)
+					x[i] = points[i * nPoints + q];
+				out[q] = (*p)(x);
+			}
+			return out[nPoints - 1];
+		};
+		BENCHMARK(std::string("Compiled, ") + label + ", " + name) {
+			compiled->Evaluate(points.data(), nPoints, out.data(), workspace.data());
+			return out[nPoints - 1];
+		};
+	}
+}
+
+TEST_CASE("Compiled Polynomial Benchmark", "[.][benchmark]") {
+	CompiledPolynomialBenchmark<2>(10, 1000);
+	CompiledPolynomialBenchmark<3>(8, 1000);
+}
+
+/*
+	p(x - c) for a dense polynomial of order k, expanding the products of the shifted variables term by term
+	against the per-variable Taylor shift.
+*/
+template<const int d>
+void TranslateBenchmark(const monOrder k) {
+	DensePolynomial<d> dense(k);
+	for (size_t alpha = 0; alpha < dense.Coefficients.size(); ++alpha)
+		dense.Coefficients[alpha] = 1.0 / (alpha + 1.0);
+	const Polynomial<d> sparse = dense.ToSparse();
+	std::array<double, d> c{};
+	for (int i = 0; i < d; ++i)
+		c[i] = 0.5 + 0.1 * i;
+	// x_i - c_i
+	std::array<Polynomial<d>, d> shifted;
+	for (int i = 0; i < d; ++i) {
+		std::array<int, d> e{};
+		e[i] = 1;
+		shifted[i].Terms[Poly<d>::Index(e)] = 1.0;
+		shifted[i].Terms[0] = -c[i];
+	}
+	const std::string name = std::to_string(d) + "D, k = " + std::to_string(k);
+
+	BENCHMARK("Expanding products " + name) {
+		Polynomial<d> result;
+		for (const auto& [alpha, a] : sparse.Terms) {
+			Polynomial<d> term;
+			term.Terms[0] = a;
+			const std::array<int, d> e = Poly<d>::Exponents(alpha);
+			for (int i = 0; i < d; ++i)
+				for (int n = 0; n < e[i]; ++n)
+					term *= shifted[i];
+			result += term;
+		}
+		return result;
+	};
+	BENCHMARK("Sparse Translate " + name) {
+		return sparse.Translate(c);
+	};
+	BENCHMARK("Dense Translate " + name) {
+		return dense.Translate(c);
+	};
+}
+
+TEST_CASE("Translate Benchmark", "[.][benchmark]") {
+	TranslateBenchmark<2>(10);
+	TranslateBenchmark<3>(8);
+}
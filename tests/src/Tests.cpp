@@ -1,18 +1,31 @@
 #include <ranges>
 #include <algorithm>
+#include <memory_resource>
+#include <stdexcept>
+#include <thread>
 #include "catch_amalgamated.hpp"
 
 #include "mnl.hpp"
 #include "pnl.hpp"
+#include "dnl.hpp"
+#include "prl.hpp"
 #include "gtq.hpp"
+#include "evl.hpp"
+#include "tbl.hpp"
+#include "itg.hpp"
+#include "glq.hpp"
 
 using namespace mnl;
 
 const int dim(const int d, const int k) {
 	if (k == -1) return 0;
 	if (k == 0) return 1;
-	return std::ranges::fold_left(std::views::iota((k > d ? k : d) + 1, k + d + 1), 1LL, std::multiplies<int>()) /
-		std::ranges::fold_left(std::views::iota(1, (k > d ? d : k) + 1), 1LL, std::multiplies<int>());
+	long long num = 1LL, den = 1LL;
+	for (const int i : std::views::iota((k > d ? k : d) + 1, k + d + 1))
+		num *= i;
+	for (const int i : std::views::iota(1, (k > d ? d : k) + 1))
+		den *= i;
+	return int(num / den);
 }
 
 TEST_CASE("Space Dimensions") {
@@ -135,6 +148,38 @@ TEST_CASE("Sum of Exponents = Order") {
 	}
 }
 
+TEST_CASE("Exponents and Index") {
+	static_assert(PSpace2D::Exponents(7) == std::array<int, 2>{ 2, 1 });
+	static_assert(PSpace2D::Index({ 2, 3 }) == 18);
+	SECTION("2D Monomials") {
+		const int d = 2;
+		for (monIndex alpha = 0; alpha < dim(d, 8); ++alpha) {
+			const std::array<int, d> e = Poly<d>::Exponents(alpha);
+			for (int x = 0; x < d; ++x)
+				REQUIRE(e[x] == Poly<d>::Exponent(alpha, x));
+			REQUIRE(Poly<d>::Index(e) == alpha);
+		}
+	}
+	SECTION("3D Monomials") {
+		const int d = 3;
+		for (monIndex alpha = 0; alpha < dim(d, 8); ++alpha) {
+			const std::array<int, d> e = Poly<d>::Exponents(alpha);
+			for (int x = 0; x < d; ++x)
+				REQUIRE(e[x] == Poly<d>::Exponent(alpha, x));
+			REQUIRE(Poly<d>::Index(e) == alpha);
+		}
+	}
+	SECTION("6D Monomials") {
+		const int d = 6;
+		for (monIndex alpha = 0; alpha < dim(d, 5); ++alpha) {
+			const std::array<int, d> e = Poly<d>::Exponents(alpha);
+			for (int x = 0; x < d; ++x)
+				REQUIRE(e[x] == Poly<d>::Exponent(alpha, x));
+			REQUIRE(Poly<d>::Index(e) == alpha);
+		}
+	}
+}
+
 TEST_CASE("Product") {
 	SECTION("2D Monomials") {
 		const int d = 2;
@@ -400,6 +445,656 @@ TEST_CASE("Product and AntiDerivatives") {
 	}
 }
 
+TEST_CASE("Compile-time evaluation") {
+	static_assert(PSpace2D::MonOrder(7) == 3);
+	static_assert(PSpace2D::Exponent(7, 0) == 2);
+	static_assert(PSpace2D::Product(5, 7) == 18);
+	static_assert(PSpace2D::D(7, 1) == 3);
+	static_assert(PSpace2D::AD(7, 1) == 12);
+	static_assert(PSpace3D::MonOrder(PSpace3D::SpaceDim(40) - 1) == 40);
+	static_assert(PSpace3D::MonOrder(PSpace3D::SpaceDim(40)) == 41);
+	SECTION("Orders beyond the tabulated ones") {
+		const int d = 2;
+		for (monOrder k = _nTabulatedOrders - 2; k < _nTabulatedOrders + 40; ++k)
+			for (monIndex alpha = dim(d, k - 1); alpha < dim(d, k); ++alpha)
+				REQUIRE(Poly<d>::MonOrder(alpha) == k);
+	}
+}
+
+/*
+	Monomial of int index alpha past the tabulated orders, checked against 64-bit indices. Returns its order.
+*/
+template<const int d>
+monOrder CheckIntIndexPastTable(const int alpha) {
+	using P = Poly<d>;
+	using Q = Poly<d, int64_t>;
+	REQUIRE(alpha >= _spaceDimTable<d, int>[_nTabulatedOrders - 1]);
+	const monOrder k = P::MonOrder(alpha);
+	REQUIRE(k == Q::MonOrder(alpha));
+	REQUIRE(P::SpaceDim(k - 1) <= alpha);
+	REQUIRE(alpha < P::SpaceDim(k));
+	for (int x = 0; x < d; ++x)
+		REQUIRE(P::Exponent(alpha, x) == Q::Exponent(alpha, x));
+	REQUIRE(P::Index(P::Exponents(alpha)) == alpha);
+	return k;
+}
+
+TEST_CASE("Binomials and 64-bit indices") {
+	SECTION("Pascal's triangle") {
+		for (int n = 1; n < _nBinomialRows; ++n) {
+			REQUIRE(Binomial(n, 0) == 1);
+			REQUIRE(Binomial(n, n) == 1);
+			for (int k = 1; k < n; ++k)
+				REQUIRE(Binomial(n, k) == Binomial(n - 1, k - 1) + Binomial(n - 1, k));
+		}
+		REQUIRE(Binomial(66, 33) == 7219428434016265740LL);
+		REQUIRE(Binomial(70, 5) == 12103014LL);
+		REQUIRE(Binomial(5, 6) == 0);
+	}
+	SECTION("Space dimensions") {
+		for (monOrder k = 0; k < 100; ++k) {
+			REQUIRE(Poly<3>::SpaceDim(k) == (k + 1) * (k + 2) * (k + 3) / 6);
+			REQUIRE(Poly<3, int64_t>::SpaceDim(k) == (k + 1) * (k + 2) * (k + 3) / 6);
+		}
+		REQUIRE(Poly<10, int64_t>::SpaceDim(30) == Binomial(40, 10));
+		REQUIRE(Poly<10, int64_t>::SpaceDim(60) == 396704524216LL);
+	}
+	SECTION("3D Monomials of order 30+") {
+		using P = Poly<3, int64_t>;
+		for (monOrder k = 30; k < 36; ++k) {
+			for (int64_t alpha = P::SpaceDim(k - 1); alpha < P::SpaceDim(k); ++alpha) {
+				REQUIRE(P::MonOrder(alpha) == k);
+				int expSum = 0;
+				for (int x = 0; x < 3; ++x) {
+					expSum += P::Exponent(alpha, x);
+					REQUIRE(P::D(P::AD(alpha, x), x) == alpha);
+				}
+				REQUIRE(expSum == k);
+			}
+		}
+	}
+	SECTION("int indices past the tabulated orders") {
+		REQUIRE(CheckIntIndexPastTable<6>(130000000) == 64);
+		REQUIRE(CheckIntIndexPastTable<6>(500000000) == 81);
+		CheckIntIndexPastTable<6>(std::numeric_limits<int>::max() - 1);
+		CheckIntIndexPastTable<4>(200000000);
+		CheckIntIndexPastTable<4>(2000000000);
+		CheckIntIndexPastTable<4>(std::numeric_limits<int>::max() - 1);
+		REQUIRE(Poly<4>::SpaceDim(1000) == std::numeric_limits<int>::max());
+	}
+	SECTION("8D Monomials beyond int indices") {
+		using P = Poly<8, int64_t>;
+		const monOrder k = 60;
+		REQUIRE(P::SpaceDim(k) > (int64_t)std::numeric_limits<int>::max());
+		for (int64_t alpha = P::SpaceDim(k) - 200; alpha < P::SpaceDim(k); ++alpha) {
+			REQUIRE(P::MonOrder(alpha) == k);
+			int64_t product = 0;
+			int expSum = 0;
+			for (int x = 0; x < 8; ++x) {
+				const int e = P::Exponent(alpha, x);
+				expSum += e;
+				for (int i = 0; i < e; ++i)
+					product = P::Product(product, x + 1);
+			}
+			REQUIRE(expSum == k);
+			REQUIRE(product == alpha);
+		}
+	}
+}
+
+template<const int d>
+void CheckPackedMonomials(const monOrder K) {
+	using P = PackedPoly<d>;
+	REQUIRE(P::FromIndex(-1) == P::Zero);
+	REQUIRE(P::ToIndex(P::Zero) == -1);
+	for (monIndex alpha = 0; alpha < Poly<d>::SpaceDim(K); ++alpha) {
+		const monWord m = P::FromIndex(alpha);
+		REQUIRE(P::ToIndex(m) == alpha);
+		REQUIRE(P::MonOrder(m) == Poly<d>::MonOrder(alpha));
+		REQUIRE(P::Unpack(m) == Poly<d>::Exponents(alpha));
+		for (int x = 0; x < d; ++x) {
+			REQUIRE(P::ToIndex(P::D(m, x)) == Poly<d>::D(alpha, x));
+			REQUIRE(P::ToIndex(P::AD(m, x)) == Poly<d>::AD(alpha, x));
+		}
+		for (monIndex beta = 0; beta < Poly<d>::SpaceDim(K); ++beta)
+			REQUIRE(P::ToIndex(P::Product(m, P::FromIndex(beta))) == Poly<d>::Product(alpha, beta));
+		REQUIRE(P::Product(m, P::Zero) == P::Zero);
+	}
+}
+
+template<const int d>
+constexpr int SumOfExponents(const monOrder k) {
+	int sum = 0;
+	for (const auto& [alpha, order, e] : Monomials<d>(k))
+		for (int i = 0; i < d; ++i)
+			sum += e[i];
+	return sum;
+}
+
+template<const int d>
+void CheckMonomialRange(const monOrder K) {
+	monIndex expected = 0;
+	for (const auto& [alpha, order, e] : Monomials<d>(K)) {
+		REQUIRE(alpha == expected++);
+		REQUIRE(order == Poly<d>::MonOrder(alpha));
+		REQUIRE(e == Poly<d>::Exponents(alpha));
+	}
+	REQUIRE(expected == Poly<d>::SpaceDim(K));
+	for (monOrder k = 0; k <= K; ++k) {
+		expected = Poly<d>::SpaceDim(k - 1);
+		for (const MonomialEntry<d>& m : MonomialsOfOrder<d>(k)) {
+			REQUIRE(m.Index == expected++);
+			REQUIRE(m.Order == k);
+			REQUIRE(m.Exponents == Poly<d>::Exponents(m.Index));
+		}
+		REQUIRE(expected == Poly<d>::SpaceDim(k));
+	}
+}
+
+TEST_CASE("Monomial Iteration") {
+	// sum over all monomials of order k of the order, for k = 0, 1, 2: 0 + 2 + 6
+	static_assert(SumOfExponents<2>(2) == 8);
+	SECTION("1D Monomials") { CheckMonomialRange<1>(6); }
+	SECTION("2D Monomials") { CheckMonomialRange<2>(8); }
+	SECTION("3D Monomials") { CheckMonomialRange<3>(6); }
+	SECTION("6D Monomials") { CheckMonomialRange<6>(4); }
+	SECTION("Empty ranges") {
+		REQUIRE(Monomials<2>(-1).begin() == Monomials<2>(-1).end());
+		REQUIRE(MonomialsOfOrder<3>(2).size() == 6);
+	}
+}
+
+TEST_CASE("Packed Monomials") {
+	static_assert(PackedPoly<2>::ToIndex(PackedPoly<2>::Product(PackedPoly<2>::FromIndex(5), PackedPoly<2>::FromIndex(7))) == 18);
+	SECTION("2D Monomials") { CheckPackedMonomials<2>(5); }
+	SECTION("3D Monomials") { CheckPackedMonomials<3>(5); }
+	SECTION("5D Monomials") { CheckPackedMonomials<5>(3); }
+	SECTION("8D Monomials") { CheckPackedMonomials<8>(2); }
+	SECTION("Largest exponents") {
+		using P = PackedPoly<8>;
+		REQUIRE(P::MaxExponent == 254);
+		std::array<int, 8> e{};
+		e.fill(254);
+		REQUIRE(P::Pack(e) != P::Zero);
+		REQUIRE(P::Unpack(P::Pack(e)) == e);
+		e.fill(0);
+		e[0] = 253;
+		const monWord m = P::AD(P::Pack(e), 0);
+		REQUIRE(P::Exponent(m, 0) == 254);
+		REQUIRE(P::Exponent(m, 1) == 0);
+		REQUIRE(P::MonOrder(P::Product(P::Pack(e), P::Pack({ 1, 1 }))) == 255);
+	}
+}
+
+TEST_CASE("Monomial Table") {
+	SECTION("2D Monomials") {
+		const int d = 2;
+		constexpr MonomialTable<d, 8> table;
+		REQUIRE(table.Size == dim(d, 8));
+		for (monIndex alpha = 0; alpha < table.Size; ++alpha) {
+			REQUIRE(Poly<d>::MonOrder(alpha, table) == Poly<d>::MonOrder(alpha));
+			for (int x = 0; x < d; ++x)
+				REQUIRE(Poly<d>::Exponent(alpha, x, table) == Poly<d>::Exponent(alpha, x));
+		}
+	}
+	SECTION("3D Monomials") {
+		const int d = 3;
+		constexpr MonomialTable<d, 8> table;
+		REQUIRE(table.Size == dim(d, 8));
+		for (monIndex alpha = 0; alpha < table.Size; ++alpha) {
+			REQUIRE(Poly<d>::MonOrder(alpha, table) == Poly<d>::MonOrder(alpha));
+			for (int x = 0; x < d; ++x)
+				REQUIRE(Poly<d>::Exponent(alpha, x, table) == Poly<d>::Exponent(alpha, x));
+		}
+	}
+	SECTION("5D Monomials") {
+		const int d = 5;
+		constexpr MonomialTable<d, 5> table;
+		REQUIRE(table.Size == dim(d, 5));
+		for (monIndex alpha = 0; alpha < table.Size; ++alpha) {
+			REQUIRE(Poly<d>::MonOrder(alpha, table) == Poly<d>::MonOrder(alpha));
+			for (int x = 0; x < d; ++x)
+				REQUIRE(Poly<d>::Exponent(alpha, x, table) == Poly<d>::Exponent(alpha, x));
+		}
+	}
+	SECTION("Fallback outside of table") {
+		const int d = 2;
+		constexpr MonomialTable<d, 3> table;
+		for (monIndex alpha = table.Size; alpha < dim(d, 6); ++alpha) {
+			REQUIRE(Poly<d>::MonOrder(alpha, table) == Poly<d>::MonOrder(alpha));
+			for (int x = 0; x < d; ++x)
+				REQUIRE(Poly<d>::Exponent(alpha, x, table) == Poly<d>::Exponent(alpha, x));
+		}
+	}
+}
+
+TEST_CASE("Product Table") {
+	SECTION("2D Monomials") {
+		const int d = 2;
+		const ProductTable<d, 6> table;
+		for (monIndex alpha = -1; alpha < table.Size; ++alpha)
+			for (monIndex beta = -1; beta < table.Size; ++beta)
+				REQUIRE(table.Product(alpha, beta) == Poly<d>::Product(alpha, beta));
+		for (monIndex alpha = 0; alpha < table.Size; ++alpha)
+			for (monIndex beta = alpha; beta < table.Size; ++beta)
+				REQUIRE(table.Row(alpha)[beta] == Poly<d>::Product(alpha, beta));
+	}
+	SECTION("3D Monomials") {
+		const int d = 3;
+		const ProductTable<d, 6> table;
+		for (monIndex alpha = -1; alpha < table.Size; ++alpha)
+			for (monIndex beta = -1; beta < table.Size; ++beta)
+				REQUIRE(table.Product(alpha, beta) == Poly<d>::Product(alpha, beta));
+	}
+	SECTION("Fallback outside of table") {
+		const int d = 2;
+		const ProductTable<d, 2> table;
+		for (monIndex alpha = 0; alpha < dim(d, 4); ++alpha)
+			for (monIndex beta = 0; beta < dim(d, 4); ++beta)
+				REQUIRE(table.Product(alpha, beta) == Poly<d>::Product(alpha, beta));
+	}
+	SECTION("Polynomial product") {
+		const ProductTable<3, 4> table;
+		pnl3D p1;
+		p1.Terms[0] = 1.;
+		p1.Terms[1] = 1.;
+		p1.Terms[2] = 1.;
+		p1.Terms[3] = 1.;
+		const pnl3D p2 = p1 * p1 * p1;
+		const pnl3D res = Multiply(Multiply(p1, p1, table), p1, table);
+		REQUIRE(res.Terms.size() == p2.Terms.size());
+		for (const auto& [index, scalar] : p2.Terms)
+			REQUIRE(res.Terms.at(index) == scalar);
+	}
+}
+
+template<const int d>
+void CheckBasisEvaluation(const monOrder k) {
+	std::array<double, d> x{};
+	for (int i = 0; i < d; ++i)
+		x[i] = 0.3 + 0.25 * i;
+	std::vector<double> values(Poly<d>::SpaceDim(k));
+	EvaluateBasis<d>(x.data(), k, values.data());
+	for (monIndex alpha = 0; alpha < Poly<d>::SpaceDim(k); ++alpha) {
+		double expected = 1.0;
+		for (int i = 0; i < d; ++i)
+			expected *= pow(x[i], Poly<d>::Exponent(alpha, i));
+		REQUIRE_THAT(values[alpha], Catch::Matchers::WithinRel(expected, 1e-13));
+	}
+}
+
+template<const int d>
+void CheckBatchBasisEvaluation(const monOrder k, const size_t nPoints) {
+	const monIndex n = Poly<d>::SpaceDim(k);
+	std::vector<double> points(d * nPoints);
+	for (size_t p = 0; p < nPoints; ++p)
+		for (int i = 0; i < d; ++i)
+			points[i * nPoints + p] = 0.1 * (double)p - 0.2 * i + 0.05;
+	std::vector<double> batch(n * nPoints), single(n);
+	EvaluateBasisBatch<d>(points.data(), nPoints, k, batch.data());
+	for (size_t p = 0; p < nPoints; ++p) {
+		std::array<double, d> x{};
+		for (int i = 0; i < d; ++i)
+			x[i] = points[i * nPoints + p];
+		EvaluateBasis<d>(x.data(), k, single.data());
+		for (monIndex alpha = 0; alpha < n; ++alpha)
+			REQUIRE(batch[p * n + alpha] == single[alpha]);
+	}
+}
+
+TEST_CASE("Batch Basis Evaluation") {
+	SECTION("2D Monomials") { CheckBatchBasisEvaluation<2>(7, 19); }
+	SECTION("3D Monomials") { CheckBatchBasisEvaluation<3>(5, 8); }
+	SECTION("4D Monomials") { CheckBatchBasisEvaluation<4>(3, 3); }
+	SECTION("Workspace") {
+		const size_t nPoints = 10;
+		std::vector<double> points(2 * nPoints, 0.5), out(Poly<2>::SpaceDim(4) * nPoints);
+		std::vector<double> workspace(BasisBatchWorkspaceSize<2>(4));
+		EvaluateBasisBatch<2>(points.data(), nPoints, 4, out.data(), workspace.data());
+		REQUIRE(out[(nPoints - 1) * Poly<2>::SpaceDim(4) + 14] == 0.0625);
+	}
+}
+
+TEST_CASE("Basis Evaluation") {
+	SECTION("1D Monomials") { CheckBasisEvaluation<1>(10); }
+	SECTION("2D Monomials") { CheckBasisEvaluation<2>(10); }
+	SECTION("3D Monomials") { CheckBasisEvaluation<3>(8); }
+	SECTION("5D Monomials") { CheckBasisEvaluation<5>(5); }
+	SECTION("Order 0") {
+		const std::array<double, 2> x{ 2., 3. };
+		double value = 0.0;
+		EvaluateBasis<2>(x.data(), 0, &value);
+		REQUIRE(value == 1.0);
+	}
+}
+
+template<const int d>
+void CheckBasisDerivatives(const monOrder k) {
+	const monIndex n = Poly<d>::SpaceDim(k);
+	std::array<double, d> x{};
+	for (int i = 0; i < d; ++i)
+		x[i] = 0.7 - 0.3 * i;
+	std::vector<double> values(n), gradients(d * n), hessians(d * (d + 1) / 2 * n), valuesOnly(n);
+	EvaluateBasisDerivatives<d>(x.data(), k, values.data(), gradients.data(), hessians.data());
+	EvaluateBasis<d>(x.data(), k, valuesOnly.data());
+	// Derivative of x^e, with exponents reduced by de, times coefficient
+	const auto derivative = [&x](std::array<int, d> e, const std::array<int, d>& de) {
+		double result = 1.0;
+		for (int i = 0; i < d; ++i) {
+			for (int r = 0; r < de[i]; ++r)
+				result *= e[i]--;
+			result *= pow(x[i], e[i]);
+		}
+		return result;
+	};
+	for (monIndex alpha = 0; alpha < n; ++alpha) {
+		const std::array<int, d> e = Poly<d>::Exponents(alpha);
+		REQUIRE(values[alpha] == valuesOnly[alpha]);
+		for (int j = 0; j < d; ++j) {
+			std::array<int, d> dj{};
+			dj[j] = 1;
+			REQUIRE_THAT(gradients[j * n + alpha], Catch::Matchers::WithinAbs(derivative(e, dj), 1e-12));
+			for (int l = j; l < d; ++l) {
+				std::array<int, d> djl{};
+				++djl[j];
+				++djl[l];
+				REQUIRE_THAT(hessians[HessianComponent<d>(j, l) * n + alpha], Catch::Matchers::WithinAbs(derivative(e, djl), 1e-12));
+			}
+		}
+	}
+}
+
+TEST_CASE("Basis Derivatives") {
+	SECTION("1D Monomials") { CheckBasisDerivatives<1>(8); }
+	SECTION("2D Monomials") { CheckBasisDerivatives<2>(8); }
+	SECTION("3D Monomials") { CheckBasisDerivatives<3>(6); }
+	SECTION("4D Monomials") { CheckBasisDerivatives<4>(4); }
+	SECTION("Without Hessians") {
+		const std::array<double, 2> x{ 2., 3. };
+		std::array<double, 6> values{};
+		std::array<double, 12> gradients{};
+		EvaluateBasisDerivatives<2>(x.data(), 2, values.data(), gradients.data());
+		// m_4 = xy
+		REQUIRE(values[4] == 6.);
+		REQUIRE(gradients[4] == 3.);
+		REQUIRE(gradients[6 + 4] == 2.);
+	}
+}
+
+template<const int d>
+void CheckScaledMonomials(const monOrder k) {
+	std::array<double, d> centroid{};
+	for (int i = 0; i < d; ++i)
+		centroid[i] = 10.0 + i;
+	const double h = 0.25;
+	ScaledMonomialBasis<d> basis(centroid, h, k);
+	const monIndex n = basis.Size();
+	REQUIRE(n == Poly<d>::SpaceDim(k));
+
+	const size_t nPoints = 11;
+	std::vector<double> points(d * nPoints);
+	for (size_t p = 0; p < nPoints; ++p)
+		for (int i = 0; i < d; ++i)
+			points[i * nPoints + p] = centroid[i] + h * (0.1 * (double)p - 0.5 + 0.2 * i);
+	std::vector<double> values(n * nPoints), values2(n * nPoints), gradients(d * n * nPoints);
+	basis.Values(points.data(), nPoints, values.data());
+	basis.ValuesAndDerivatives(points.data(), nPoints, values2.data(), gradients.data());
+	for (size_t p = 0; p < nPoints; ++p) {
+		for (monIndex alpha = 0; alpha < n; ++alpha) {
+			const std::array<int, d> e = Poly<d>::Exponents(alpha);
+			double expected = 1.0;
+			for (int i = 0; i < d; ++i)
+				expected *= pow((points[i * nPoints + p] - centroid[i]) / h, e[i]);
+			REQUIRE_THAT(values[p * n + alpha], Catch::Matchers::WithinAbs(expected, 1e-12));
+			REQUIRE_THAT(values2[p * n + alpha], Catch::Matchers::WithinAbs(expected, 1e-12));
+			for (int j = 0; j < d; ++j) {
+				double derivative = e[j] / h;
+				for (int i = 0; i < d && e[j] > 0; ++i)
+					derivative *= pow((points[i * nPoints + p] - centroid[i]) / h, e[i] - (i == j));
+				REQUIRE_THAT(gradients[(p * d + j) * n + alpha], Catch::Matchers::WithinAbs(derivative, 1e-10));
+			}
+		}
+	}
+}
+
+TEST_CASE("Scaled Monomials") {
+	SECTION("2D Monomials") { CheckScaledMonomials<2>(5); }
+	SECTION("3D Monomials") { CheckScaledMonomials<3>(4); }
+	SECTION("Hessians") {
+		// m_3 = ((x - 1) / 2)^2, d/dx = (x - 1) / 2, d2/dx2 = 1 / 2
+		ScaledMonomialBasis<2> basis({ 1., 1. }, 2., 2);
+		const std::array<double, 2> point{ 3., 5. };
+		std::array<double, 6> values{};
+		std::array<double, 12> gradients{};
+		std::array<double, 18> hessians{};
+		basis.ValuesAndDerivatives(point.data(), 1, values.data(), gradients.data(), hessians.data());
+		REQUIRE(values[3] == 1.);
+		REQUIRE(gradients[3] == 1.);
+		REQUIRE(hessians[HessianComponent<2>(0, 0) * 6 + 3] == 0.5);
+		REQUIRE(basis.DerivativeScale(2) == 0.25);
+	}
+}
+
+TEST_CASE("Derivative and Antiderivative Tables") {
+	SECTION("Tables") {
+		const int d = 3;
+		static constexpr DerivativeTable<d, 5> dTable;
+		static constexpr AntiderivativeTable<d, 5> adTable;
+		static_assert(DerivativeTable<2, 3>().Target(7, 0) == 4);
+		for (monIndex alpha = 0; alpha < dTable.Size; ++alpha) {
+			for (int x = 0; x < d; ++x) {
+				REQUIRE(dTable.Target(alpha, x) == Poly<d>::D(alpha, x));
+				REQUIRE(dTable.Coefficient(alpha, x) == Poly<d>::Exponent(alpha, x));
+				REQUIRE(adTable.Target(alpha, x) == Poly<d>::AD(alpha, x));
+				REQUIRE(adTable.Coefficient(alpha, x) == 1.0 / (Poly<d>::Exponent(alpha, x) + 1));
+			}
+		}
+	}
+	SECTION("Operators") {
+		// p = x^2y + 3y^3 = m_7 + 3 m_9
+		static constexpr DerivativeTable<2, 3> table;
+		std::array<double, 10> p{};
+		p[7] = 1.0;
+		p[9] = 3.0;
+
+		// d/dx(p) = 2xy, d/dy(p) = x^2 + 9y^2
+		const CSRMatrix gradient = table.Gradient();
+		REQUIRE(gradient.Rows == 12);
+		std::array<double, 12> grad{};
+		gradient.Multiply(p.data(), grad.data());
+		for (monIndex beta = 0; beta < 6; ++beta) {
+			REQUIRE(grad[beta] == (beta == 4 ? 2.0 : 0.0));
+			REQUIRE(grad[6 + beta] == (beta == 3 ? 1.0 : (beta == 5 ? 9.0 : 0.0)));
+		}
+		std::array<double, 6> dy{};
+		table.Operator(1).Multiply(p.data(), dy.data());
+		for (monIndex beta = 0; beta < 6; ++beta)
+			REQUIRE(dy[beta] == grad[6 + beta]);
+
+		// Laplacian(p) = 2y + 18y = 20y
+		const CSRMatrix laplacian = table.Laplacian();
+		REQUIRE(laplacian.Rows == 3);
+		std::array<double, 3> lap{};
+		laplacian.Multiply(p.data(), lap.data());
+		REQUIRE(lap[0] == 0.0);
+		REQUIRE(lap[1] == 0.0);
+		REQUIRE(lap[2] == 20.0);
+
+		// div(p, p) = 2xy + x^2 + 9y^2
+		std::array<double, 20> u{};
+		std::copy(p.begin(), p.end(), u.begin());
+		std::copy(p.begin(), p.end(), u.begin() + 10);
+		std::array<double, 6> div{};
+		table.Divergence().Multiply(u.data(), div.data());
+		REQUIRE(div[3] == 1.0);
+		REQUIRE(div[4] == 2.0);
+		REQUIRE(div[5] == 9.0);
+
+		// Antiderivative in x of p: x^3y / 3 + 3xy^3
+		static constexpr AntiderivativeTable<2, 3> adTable;
+		std::array<double, 15> ad{};
+		adTable.Operator(0).Multiply(p.data(), ad.data());
+		REQUIRE_THAT(ad[11], Catch::Matchers::WithinAbs(1.0 / 3.0, 1e-15));
+		REQUIRE(ad[13] == 3.0);
+		// and back
+		const CSRMatrix dx4 = DerivativeTable<2, 4>().Operator(0);
+		std::array<double, 10> back{};
+		dx4.Multiply(ad.data(), back.data());
+		for (monIndex alpha = 0; alpha < 10; ++alpha)
+			REQUIRE_THAT(back[alpha], Catch::Matchers::WithinAbs(p[alpha], 1e-15));
+	}
+}
+
+TEST_CASE("Reference Moments") {
+	SECTION("Compile-time moments") {
+		constexpr auto simplex = ReferenceMoments<3>::Simplex<2>();
+		static_assert(simplex[0] == 1.0);
+		static_assert(simplex[1] == 0.25); // mean of x over the tetrahedron
+		constexpr auto cube = ReferenceMoments<2>::Cube<2>();
+		static_assert(cube[4] == 0.25);    // xy over [0,1]^2
+		const std::vector<double> runtime = ReferenceMoments<3>::Simplex(2);
+		REQUIRE(runtime.size() == simplex.size());
+		for (size_t alpha = 0; alpha < runtime.size(); ++alpha)
+			REQUIRE(runtime[alpha] == simplex[alpha]);
+	}
+	SECTION("Triangle against quadrature") {
+		const monOrder k = 14;
+		const std::vector<double> moments = ReferenceMoments<2>::Simplex(k);
+		std::vector<double> quadrature(moments.size(), 0.0), values(moments.size());
+		for (const auto& qData : GaussLegendreTriangle(k)) {
+			const double x[2] = { qData[0], qData[1] };
+			EvaluateBasis<2>(x, k, values.data());
+			for (size_t alpha = 0; alpha < values.size(); ++alpha)
+				quadrature[alpha] += qData[2] * values[alpha];
+		}
+		for (size_t alpha = 0; alpha < moments.size(); ++alpha)
+			REQUIRE_THAT(moments[alpha], Catch::Matchers::WithinAbs(quadrature[alpha], 1e-12));
+	}
+	SECTION("Square against quadrature") {
+		const monOrder k = 10;
+		const std::vector<double> moments = ReferenceMoments<2>::Cube(k);
+		std::vector<double> quadrature(moments.size(), 0.0), values(moments.size());
+		const auto rule = GaussLegendreR(k);
+		for (const auto& qx : rule) {
+			for (const auto& qy : rule) {
+				const double x[2] = { qx[0], qy[0] };
+				EvaluateBasis<2>(x, k, values.data());
+				for (size_t alpha = 0; alpha < values.size(); ++alpha)
+					quadrature[alpha] += qx[1] * qy[1] * values[alpha];
+			}
+		}
+		for (size_t alpha = 0; alpha < moments.size(); ++alpha)
+			REQUIRE_THAT(moments[alpha], Catch::Matchers::WithinAbs(quadrature[alpha], 1e-12));
+	}
+	SECTION("High order simplex moments") {
+		// x^30 over the tetrahedron, normalized: 30! 3! / 33!
+		const monIndex alpha = Poly<3>::Index({ 30, 0, 0 });
+		REQUIRE_THAT(ReferenceMoments<3>::Simplex(30)[alpha], Catch::Matchers::WithinRel(6.0 / (31.0 * 32.0 * 33.0), 1e-14));
+	}
+}
+
+// Integrals of all monomials up to order k over the rectangle [x0, x1] x [y0, y1] with tensor Gauss-Legendre rules.
+static std::vector<double> RectangleMoments(const double x0, const double x1, const double y0, const double y1, const monOrder k) {
+	std::vector<double> moments(Poly<2>::SpaceDim(k), 0.0), values(moments.size());
+	const auto rule = GaussLegendreR(k);
+	for (const auto& qx : rule) {
+		for (const auto& qy : rule) {
+			const double x[2] = { x0 + (x1 - x0) * qx[0], y0 + (y1 - y0) * qy[0] };
+			EvaluateBasis<2>(x, k, values.data());
+			for (size_t alpha = 0; alpha < values.size(); ++alpha)
+				moments[alpha] += (x1 - x0) * (y1 - y0) * qx[1] * qy[1] * values[alpha];
+		}
+	}
+	return moments;
+}
+
+TEST_CASE("Polygon Integration") {
+	const monOrder k = 10;
+	SECTION("Unit square") {
+		const std::vector<double> integrals = IntegratePolygonMonomials({ {0., 0.}, {1., 0.}, {1., 1.}, {0., 1.} }, k);
+		const std::vector<double> moments = ReferenceMoments<2>::Cube(k);
+		REQUIRE(integrals.size() == moments.size());
+		for (size_t alpha = 0; alpha < moments.size(); ++alpha)
+			REQUIRE_THAT(integrals[alpha], Catch::Matchers::WithinAbs(moments[alpha], 1e-14));
+	}
+	SECTION("Reference triangle") {
+		const std::vector<double> integrals = IntegratePolygonMonomials({ {0., 0.}, {1., 0.}, {0., 1.} }, k);
+		const std::vector<double> moments = ReferenceMoments<2>::Simplex(k);
+		for (size_t alpha = 0; alpha < moments.size(); ++alpha)
+			REQUIRE_THAT(integrals[alpha], Catch::Matchers::WithinAbs(0.5 * moments[alpha], 1e-14));
+	}
+	SECTION("Shifted rectangle") {
+		const std::vector<double> integrals = IntegratePolygonMonomials({ {-0.5, 0.25}, {0.75, 0.25}, {0.75, 1.}, {-0.5, 1.} }, k);
+		const std::vector<double> moments = RectangleMoments(-0.5, 0.75, 0.25, 1., k);
+		for (size_t alpha = 0; alpha < moments.size(); ++alpha)
+			REQUIRE_THAT(integrals[alpha], Catch::Matchers::WithinAbs(moments[alpha], 1e-12));
+	}
+	SECTION("Nonconvex polygon") {
+		// L-shape [-1,1]x[-1,0] + [-1,0]x[0,1], with a collinear vertex
+		const std::vector<double> integrals = IntegratePolygonMonomials({ {-1., -1.}, {0., -1.}, {1., -1.}, {1., 0.}, {0., 0.}, {0., 1.}, {-1., 1.} }, k);
+		const std::vector<double> bottom = RectangleMoments(-1., 1., -1., 0., k), top = RectangleMoments(-1., 0., 0., 1., k);
+		for (size_t alpha = 0; alpha < bottom.size(); ++alpha)
+			REQUIRE_THAT(integrals[alpha], Catch::Matchers::WithinAbs(bottom[alpha] + top[alpha], 1e-12));
+	}
+}
+
+// Box [lo, hi] as vertices and outward counterclockwise faces.
+static std::vector<std::array<double, 3>> BoxVertices(const std::array<double, 3>& lo, const std::array<double, 3>& hi) {
+	std::vector<std::array<double, 3>> vertices;
+	for (int v = 0; v < 8; ++v)
+		vertices.push_back({ (v & 1) ? hi[0] : lo[0], (v & 2) ? hi[1] : lo[1], (v & 4) ? hi[2] : lo[2] });
+	return vertices;
+}
+static const std::vector<std::vector<int>> boxFaces = { {0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5} };
+
+TEST_CASE("Polyhedron Integration") {
+	const monOrder k = 8;
+	SECTION("Unit cube") {
+		const std::vector<double> integrals = IntegratePolyhedronMonomials(BoxVertices({ 0., 0., 0. }, { 1., 1., 1. }), boxFaces, k);
+		const std::vector<double> moments = ReferenceMoments<3>::Cube(k);
+		REQUIRE(integrals.size() == moments.size());
+		for (size_t alpha = 0; alpha < moments.size(); ++alpha)
+			REQUIRE_THAT(integrals[alpha], Catch::Matchers::WithinAbs(moments[alpha], 1e-14));
+	}
+	SECTION("Reference tetrahedron") {
+		const std::vector<double> integrals = IntegratePolyhedronMonomials({ {0., 0., 0.}, {1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.} }, { {0, 2, 1}, {0, 1, 3}, {0, 3, 2}, {1, 2, 3} }, k);
+		const std::vector<double> moments = ReferenceMoments<3>::Simplex(k);
+		for (size_t alpha = 0; alpha < moments.size(); ++alpha)
+			REQUIRE_THAT(integrals[alpha], Catch::Matchers::WithinAbs(moments[alpha] / 6., 1e-14));
+	}
+	SECTION("Shifted box") {
+		const std::array<double, 3> lo{ -0.5, 0.25, -0.75 }, hi{ 0.75, 1., 0.5 };
+		const std::vector<double> integrals = IntegratePolyhedronMonomials(BoxVertices(lo, hi), boxFaces, k);
+		for (const MonomialEntry<3>& m : Monomials<3>(k)) {
+			double expected = 1.;
+			for (int i = 0; i < 3; ++i)
+				expected *= (std::pow(hi[i], m.Exponents[i] + 1) - std::pow(lo[i], m.Exponents[i] + 1)) / (m.Exponents[i] + 1);
+			REQUIRE_THAT(integrals[m.Index], Catch::Matchers::WithinAbs(expected, 1e-13));
+		}
+	}
+	SECTION("Nonconvex prism") {
+		// L-shaped polygon extruded over z in [0, 1], with a collinear vertex
+		const std::vector<std::array<double, 2>> polygon = { {-1., -1.}, {0., -1.}, {1., -1.}, {1., 0.}, {0., 0.}, {0., 1.}, {-1., 1.} };
+		const int n = (int)polygon.size();
+		std::vector<std::array<double, 3>> vertices;
+		for (int z = 0; z < 2; ++z)
+			for (const auto& p : polygon)
+				vertices.push_back({ p[0], p[1], (double)z });
+		std::vector<std::vector<int>> faces(2);
+		for (int v = 0; v < n; ++v) {
+			faces[0].push_back(n - 1 - v);
+			faces[1].push_back(n + v);
+			faces.push_back({ v, (v + 1) % n, n + (v + 1) % n, n + v });
+		}
+		const std::vector<double> integrals = IntegratePolyhedronMonomials(vertices, faces, k);
+		const std::vector<double> section = IntegratePolygonMonomials(polygon, k);
+		for (const MonomialEntry<3>& m : Monomials<3>(k)) {
+			const double expected = section[Poly<2>::Index({ m.Exponents[0], m.Exponents[1] })] / (m.Exponents[2] + 1);
+			REQUIRE_THAT(integrals[m.Index], Catch::Matchers::WithinAbs(expected, 1e-13));
+		}
+	}
+}
+
 TEST_CASE("README Tests") {
 	SECTION("mnl.hpp"){
 		// Space Dimension
@@ -455,6 +1150,88 @@ TEST_CASE("README Tests") {
 		// m_7 = x^2y = x^2 * y^1
 		REQUIRE(mnl::PSpace2D::AD(7, 0) == 11);  // ADx(x^2y) ~ x^3y   = m_11
 		REQUIRE(mnl::PSpace2D::AD(7, 1) == 12);  // ADy(x^2y) ~ x^2y^2 = m_12
+
+		// Exponents and Index
+		REQUIRE(mnl::PSpace2D::Exponents(7) == std::array<int, 2>{2, 1});
+		REQUIRE(mnl::PSpace2D::Index({2, 1}) == 7);
+
+		// Iteration
+		// m_3 = x^2, m_4 = xy, m_5 = y^2
+		for (const auto& [alpha, k, e] : mnl::MonomialsOfOrder<2>(2))
+			REQUIRE(e == mnl::PSpace2D::Exponents(alpha));
+
+		// Packed Monomials
+		using P = mnl::PackedPoly<2>;
+		const mnl::monWord m5 = P::FromIndex(5), m7 = P::FromIndex(7); // y^2, x^2y
+		REQUIRE(P::ToIndex(P::Product(m5, m7)) == 18);                  // x^2y^3 = m_18
+		REQUIRE(P::ToIndex(P::D(m7, 0)) == 4);                          // d/dx(x^2y) ~ xy = m_4
+		REQUIRE(P::D(m5, 0) == P::Zero);                                // d/dx(y^2) = 0
+
+		// Monomial Table
+		constexpr mnl::MonomialTable<2, 10> table; // m_0, ..., m_65
+		REQUIRE(mnl::PSpace2D::MonOrder(7, table) == 3);
+		REQUIRE(mnl::PSpace2D::Exponent(7, 0, table) == 2);
+		REQUIRE(mnl::PSpace2D::Exponent(7, 1, table) == 1);
+	}
+	SECTION("evl.hpp") {
+		const double x[2] = {2., 3.};
+		double values[6];                      // SpaceDim(2) = 6
+		mnl::EvaluateBasis<2>(x, 2, values);   // {1, x, y, x^2, xy, y^2}
+		REQUIRE(values[4] == 6.);              // m_4 = xy
+	}
+	SECTION("evl.hpp derivatives") {
+		const double x[2] = {2., 3.};
+		double values[6], gradients[12];
+		mnl::EvaluateBasisDerivatives<2>(x, 2, values, gradients);
+		REQUIRE(gradients[0 * 6 + 4] == 3.);   // d/dx(xy) = y
+		REQUIRE(gradients[1 * 6 + 4] == 2.);   // d/dy(xy) = x
+
+		mnl::ScaledMonomialBasis<2> basis({1., 1.}, 2., 2); // x_E = (1, 1), h_E = 2, k = 2
+		const double point[2] = {3., 5.};                    // local coordinates (1, 2)
+		double scaledValues[6], scaledGradients[12];
+		basis.ValuesAndDerivatives(point, 1, scaledValues, scaledGradients);
+		REQUIRE(scaledValues[4] == 2.);                      // m_4 = xy
+		REQUIRE(scaledGradients[0 * 6 + 4] == 1.);           // d/dx(m_4) = y / h_E
+	}
+	SECTION("evl.hpp compiled") {
+		mnl::pnl2D p;
+		p.Terms[mnl::Poly<2>::Index({5, 3})] = 1.;            // x^5 y^3
+		p.Terms[mnl::Poly<2>::Index({0, 2})] = -2.;           // - 2 y^2
+		const mnl::CompiledPolynomial<2> compiled(p.Terms);
+		REQUIRE(compiled.Size() == 9);                        // 1, y, y^2, y^3, xy^3, ..., x^5 y^3
+		const double points[4] = {2., 1., 0.5, 1.};           // (2, 0.5) and (1, 1)
+		double values[2];
+		compiled.Evaluate(points, 2, values);
+		REQUIRE(values[0] == 3.5);
+		REQUIRE(values[1] == -1.);
+	}
+	SECTION("tbl.hpp") {
+		const mnl::ProductTable<2, 5> table;
+		// m_5 * m_7 = y^2 * x^2y = x^2y^3 = m_18
+		REQUIRE(table.Product(5, 7) == 18);
+		REQUIRE(table.Row(5)[7] == 18);
+
+		constexpr mnl::DerivativeTable<2, 3> dTable;
+		// d/dx(x^2y) = 2xy = 2 m_4
+		REQUIRE(dTable.Target(7, 0) == 4);
+		REQUIRE(dTable.Coefficient(7, 0) == 2);
+		// p = x^2y + 3y^3 = m_7 + 3 m_9
+		const double p[10] = {0., 0., 0., 0., 0., 0., 0., 1., 0., 3.};
+		double lap[3];
+		dTable.Laplacian().Multiply(p, lap); // 20y
+		REQUIRE(lap[2] == 20.);
+	}
+	SECTION("itg.hpp") {
+		constexpr auto moments = mnl::ReferenceMoments<2>::Simplex<2>(); // {1, x, y, x^2, xy, y^2}
+		static_assert(moments[1] == 1. / 3.);                             // mean of x over the triangle
+		REQUIRE(mnl::ReferenceMoments<2>::Cube(2)[4] == 0.25);            // xy over [0,1]^2
+		const std::vector<double> integrals = mnl::IntegratePolygonMonomials({{0., 0.}, {2., 0.}, {2., 1.}, {0., 1.}}, 2);
+		REQUIRE(integrals[0] == 2.);   // area
+		REQUIRE(integrals[4] == 1.);   // xy over [0,2]x[0,1]
+		const std::vector<std::array<double, 3>> tetrahedron = {{0., 0., 0.}, {1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}};
+		const std::vector<double> volumes = mnl::IntegratePolyhedronMonomials(tetrahedron, {{0, 2, 1}, {0, 1, 3}, {0, 3, 2}, {1, 2, 3}}, 1);
+		REQUIRE_THAT(volumes[0], Catch::Matchers::WithinAbs(1. / 6., 1e-15));    // volume
+		REQUIRE_THAT(volumes[1], Catch::Matchers::WithinAbs(1. / 24., 1e-15));   // x
 	}
 	SECTION("pnl.hpp"){
 		mnl::pnl2D p, q;
@@ -486,6 +1263,87 @@ TEST_CASE("README Tests") {
 		REQUIRE(p.Terms[6]  == 2.0); // 2 * x^3     = 2 * m_6
 		REQUIRE(p.Terms[9]  == 3.0); // 3 * y^3     = 3 * m_9
 	}
+	SECTION("pnl.hpp backends") {
+		mnl::Polynomial<2, mnl::OpenHashMap<mnl::monIndex, double>> h;
+		h.Terms[1] = 1.;
+		h.Terms[0] = 1.;           // x + 1
+		h *= h;                    // x^2 + 2x + 1
+		REQUIRE(h.Terms.at(3) == 1.);
+		REQUIRE(h.Terms.size() == 3);
+	}
+	SECTION("pnl.hpp truncated") {
+		mnl::pnl2D s;
+		s.Terms[0] = 1.;
+		s.Terms[1] = 1.;           // 1 + x
+		const mnl::pnl2D t = mnl::MultiplyTruncated(s, s, 1);
+		REQUIRE(t.Terms.size() == 2); // 1 + 2x, without x^2
+		REQUIRE(t.Terms.at(1) == 2.);
+	}
+	SECTION("pnl.hpp lazy") {
+		mnl::pnl2D u, v, w;
+		u.Terms[1] = 1.;           // x
+		v.Terms[2] = 1.;           // y
+		w = mnl::Lazy(u) * mnl::Lazy(v) + 2.0 * mnl::Lazy(u);
+		REQUIRE(w.Terms.at(4) == 1.); // xy
+		REQUIRE(w.Terms.at(1) == 2.); // 2x
+		w = mnl::Lazy(w) - mnl::Lazy(u) * mnl::Lazy(v); // the destination can appear in the expression
+		REQUIRE(w.Terms.size() == 1);
+	}
+	SECTION("pnl.hpp in place") {
+		std::pmr::unsynchronized_pool_resource pool;
+		mnl::PmrPolynomial<2> a(&pool), b(&pool), product(&pool);
+		a.Terms[1] = 1.;           // x
+		b.Terms[2] = 1.;           // y
+		for (int element = 0; element < 3; ++element)
+			mnl::MultiplyInto(product, a, b);
+		REQUIRE(product.Terms.at(4) == 1.); // xy = m_4
+	}
+	SECTION("pnl.hpp flat") {
+		mnl::FlatPolynomial<2> f({{1, 1.}, {0, 1.}});   // x + 1, sorted on construction
+		f *= f;                                        // x^2 + 2x + 1
+		REQUIRE(f.Terms.size() == 3);
+		REQUIRE(f.Terms.front().first == 0);
+		REQUIRE(f.Coefficient(1) == 2.);               // 2 * x = 2 * m_1
+		REQUIRE(f.ToSparse().Terms[3] == 1.);          // x^2 = m_3
+	}
+	SECTION("pnl.hpp change of variables") {
+		mnl::pnl2D l;
+		l.Terms[3] = 1.;                                // x^2 in local coordinates
+		const mnl::pnl2D g = l.Scale(2.).Translate({1., 0.}); // ((x - 1) / 2)^2, x_E = (1, 0), h_E = 2
+		REQUIRE(g.Terms.at(0) == 0.25);
+		REQUIRE(g.Terms.at(1) == -0.5);
+		REQUIRE(g.Terms.at(3) == 0.25);
+	}
+	SECTION("dnl.hpp") {
+		mnl::dnl2D p(1);
+		p.Coefficients = {1., 1., 1.};        // 1 + x + y
+		mnl::dnl2D q = p * p;                 // 1 + 2x + 2y + x^2 + 2xy + y^2
+		REQUIRE(q.Coefficients[4] == 2.);     // 2 * xy = 2 * m_4
+		REQUIRE(q.D(1).Coefficients[2] == 2.); // d/dy(q) = 2 + 2x + 2y
+		REQUIRE(q({1., 1.}) == 9.);
+		REQUIRE(q.ToSparse().Terms.size() == 6);
+	}
+	SECTION("dnl.hpp batch") {
+		mnl::DensePolynomialBatch<2> batch(1, 3);   // 3 polynomials of order 1
+		for (size_t e = 0; e < 3; ++e) {
+			mnl::dnl2D element(1);
+			element.Coefficients = {1., double(e), 0.}; // 1 + e x
+			batch.Set(e, element);
+		}
+		const mnl::ProductSchedule<2> schedule(1, 1);
+		mnl::DensePolynomialBatch<2> squares;
+		mnl::MultiplyInto(squares, batch, batch, schedule);
+		REQUIRE(squares.Get(2).Coefficients[3] == 4.); // (1 + 2x)^2 = 1 + 4x + 4x^2
+	}
+	SECTION("prl.hpp") {
+		mnl::DensePolynomial<3> big(10);
+		for (size_t alpha = 0; alpha < big.Coefficients.size(); ++alpha)
+			big.Coefficients[alpha] = 1. / (alpha + 1.);
+		const mnl::DensePolynomial<3> product = mnl::MultiplyParallel(big, big, 4);
+		const mnl::DensePolynomial<3> sequential = big * big;
+		for (size_t alpha = 0; alpha < product.Coefficients.size(); ++alpha)
+			REQUIRE(product.Coefficients[alpha] == Catch::Approx(sequential.Coefficients[alpha]).epsilon(1e-14));
+	}
 }
 
 TEST_CASE("2D Polynomials") {
@@ -537,6 +1395,26 @@ TEST_CASE("2D Polynomials") {
 		REQUIRE(p1.Terms.size() == 2);
 		REQUIRE(p1.Order() == 2);
 	}
+	SECTION("Small coefficients") {
+		// (x-0.5)(x+0.5) = x^2 - 0.25, |-0.25| < 1 must be kept while near-zero terms are pruned
+		pnl2D p1, p2;
+		p1.Terms[1] = 1.;
+		p1.Terms[0] = -0.5;
+		p2.Terms[1] = 1.;
+		p2.Terms[0] = 0.5;
+		p1 *= p2;
+		REQUIRE(p1.Terms.size() == 2);
+		REQUIRE(p1.Terms[0] == -0.25);
+		REQUIRE(p1.Terms[3] == 1.0);
+
+		pnl2D p3;
+		p3.Terms[0] = -1e-12;
+		p3.Terms[1] = -0.5;
+		p3.Terms[2] = 1e-12;
+		p3.CheckZeroes();
+		REQUIRE(p3.Terms.size() == 1);
+		REQUIRE(p3.Terms[1] == -0.5);
+	}
 }
 
 TEST_CASE("3D Polynomials") {
@@ -589,6 +1467,654 @@ TEST_CASE("3D Polynomials") {
 	}
 }
 
+TEST_CASE("Dense Polynomials") {
+	SECTION("2D Polynomials") {
+		const int d = 2;
+		// p1 = 1 + 2x - y, p2 = x + xy
+		DensePolynomial<d> p1(1), p2(2);
+		p1.Coefficients = { 1., 2., -1. };
+		p2.Coefficients = { 0., 1., 0., 0., 1., 0. };
+		SECTION("Sum") {
+			// Coefficients of the lower order operand are added to the first ones of the other
+			REQUIRE((p1 + p2).Coefficients == std::vector<double>{ 1., 3., -1., 0., 1., 0. });
+			REQUIRE((p2 + p1).Coefficients == std::vector<double>{ 1., 3., -1., 0., 1., 0. });
+		}
+		SECTION("Product") {
+			// x + xy + 2x^2 + 2x^2y - xy - xy^2 = x + 2x^2 + 2x^2y - xy^2, the terms in xy cancelling
+			const DensePolynomial<d> product = p1 * p2;
+			REQUIRE(product.Order() == 3);
+			REQUIRE(product.Coefficients == std::vector<double>{ 0., 1., 0., 2., 0., 0., 0., 2., -1., 0. });
+			REQUIRE(product(std::array<double, d>{ 2., 3. }) == 16.);
+			DensePolynomial<d> inPlace = p1;
+			inPlace *= p2;
+			REQUIRE(inPlace.Coefficients == product.Coefficients);
+			REQUIRE((p1 * DensePolynomial<d>()).Order() == -1);
+		}
+		SECTION("Derivatives") {
+			// d/dx (x + 2x^2 + 2x^2y - xy^2) = 1 + 4x + 4xy - y^2, d/dy = 2x^2 - 2xy
+			const DensePolynomial<d> product = p1 * p2;
+			REQUIRE(product.D(0).Coefficients == std::vector<double>{ 1., 4., 0., 0., 4., -1. });
+			REQUIRE(product.D(1).Coefficients == std::vector<double>{ 0., 0., 0., 2., -2., 0. });
+			REQUIRE(DensePolynomial<d>(0).D(0).Order() == -1);
+		}
+		SECTION("Conversion to sparse") {
+			// Null coefficients are left out
+			const Polynomial<d> sparse = (p1 * p2).ToSparse();
+			REQUIRE(sparse.Terms.size() == 4);
+			REQUIRE(sparse.Terms.at(1) == 1.);
+			REQUIRE(sparse.Terms.at(3) == 2.);
+			REQUIRE(sparse.Terms.at(7) == 2.);
+			REQUIRE(sparse.Terms.at(8) == -1.);
+			REQUIRE(DensePolynomial<d>(sparse).Coefficients == (p1 * p2).Coefficients);
+		}
+	}
+	SECTION("(x+y)^2") {
+		dnl2D p(1);
+		p.Coefficients = { 0., 1., 1. };
+		p *= p;
+		REQUIRE(p.Coefficients == std::vector<double>{ 0., 0., 0., 1., 2., 1. });
+		REQUIRE(p.D(0).Coefficients == std::vector<double>{ 0., 2., 2. });
+	}
+}
+
+template<const int d>
+void CheckFlatPolynomials(const monOrder k) {
+	Polynomial<d> s1, s2;
+	for (monIndex alpha = 0; alpha < Poly<d>::SpaceDim(k); alpha += 3)
+		s1.Terms[alpha] = 1.0 / (alpha + 1.0);
+	for (monIndex alpha = 1; alpha < Poly<d>::SpaceDim(k - 1); alpha += 4)
+		s2.Terms[alpha] = -1.0 / (alpha + 2.0);
+	const FlatPolynomial<d> f1(s1), f2(s2);
+	REQUIRE(std::is_sorted(f1.Terms.begin(), f1.Terms.end()));
+	REQUIRE(f1.Terms.size() == s1.Terms.size());
+	REQUIRE(f1.Order() == s1.Order());
+
+	Polynomial<d> sparseSum = s1;
+	sparseSum += s2;
+	const Polynomial<d> sparseProduct = s1 * s2;
+	const FlatPolynomial<d> sum = f1 + f2, product = f1 * f2;
+	REQUIRE(std::is_sorted(product.Terms.begin(), product.Terms.end()));
+	REQUIRE(sum.Terms.size() == sparseSum.Terms.size());
+	REQUIRE(product.Terms.size() == sparseProduct.Terms.size());
+	for (const auto& [index, scalar] : sparseSum.Terms)
+		REQUIRE_THAT(sum.Coefficient(index), Catch::Matchers::WithinAbs(scalar, 1e-14));
+	for (const auto& [index, scalar] : sparseProduct.Terms)
+		REQUIRE_THAT(product.Coefficient(index), Catch::Matchers::WithinAbs(scalar, 1e-14));
+	REQUIRE(product.ToSparse().Terms.size() == sparseProduct.Terms.size());
+
+	const ProductTable<d, 8> table;
+	REQUIRE(Multiply(f1, f2, table).Terms == product.Terms);
+	FlatPolynomial<d> inPlace = f1;
+	inPlace *= f2;
+	inPlace += f1;
+	REQUIRE(inPlace.Terms == (product + f1).Terms);
+}
+
+TEST_CASE("Flat Polynomials") {
+	SECTION("1D") { CheckFlatPolynomials<1>(8); }
+	SECTION("2D") { CheckFlatPolynomials<2>(8); }
+	SECTION("3D") { CheckFlatPolynomials<3>(6); }
+	SECTION("(x+1)(x-1)") {
+		FlatPolynomial<2> p1({ {1, 1.}, {0, 1.} }), p2({ {0, -1.}, {1, 1.} });
+		p1 *= p2;
+		REQUIRE(p1.Terms == std::vector<std::pair<monIndex, double>>{ {0, -1.}, {3, 1.} });
+		REQUIRE(p1.Order() == 2);
+		p1 += FlatPolynomial<2>({ {0, 1.} });
+		REQUIRE(p1.Terms.size() == 1);
+		REQUIRE(p1.Coefficient(3) == 1.);
+		REQUIRE(p1.Coefficient(4) == 0.);
+	}
+}
+
+TEST_CASE("Open Hash Map") {
+	SECTION("Against std::unordered_map") {
+		OpenHashMap<monIndex, double> map;
+		std::unordered_map<monIndex, double> reference;
+		uint32_t state = 12345u;
+		for (int step = 0; step < 20000; ++step) {
+			state = state * 1664525u + 1013904223u;
+			const monIndex key = (monIndex)((state >> 8) % 512);
+			if ((state >> 4) % 3 == 0) {
+				REQUIRE(map.erase(key) == reference.erase(key));
+			}
+			else {
+				map[key] += 1.0;
+				reference[key] += 1.0;
+			}
+			REQUIRE(map.size() == reference.size());
+		}
+		size_t visited = 0;
+		for (const auto& [key, value] : map) {
+			REQUIRE(reference.at(key) == value);
+			++visited;
+		}
+		REQUIRE(visited == reference.size());
+		for (const auto& [key, value] : reference)
+			REQUIRE(map.at(key) == value);
+		REQUIRE(map.count(1000) == 0);
+		REQUIRE(map.find(1000) == map.end());
+	}
+	SECTION("Erasing while iterating") {
+		OpenHashMap<monIndex, double> map;
+		for (monIndex key = 0; key < 1000; ++key)
+			map[key] = (double)(key % 2);
+		for (auto it = map.begin(); it != map.end();) {
+			if (it->second == 0.0)
+				it = map.erase(it);
+			else
+				++it;
+		}
+		REQUIRE(map.size() == 500);
+		for (monIndex key = 0; key < 1000; ++key)
+			REQUIRE(map.count(key) == (size_t)(key % 2));
+	}
+	SECTION("Clear keeps the slots") {
+		OpenHashMap<monIndex, double> map;
+		map.reserve(100);
+		const size_t slots = map.bucket_count();
+		REQUIRE(slots >= 134);
+		for (monIndex key = 0; key < 100; ++key)
+			map[key] = 1.0;
+		REQUIRE(map.bucket_count() == slots);
+		map.clear();
+		REQUIRE(map.empty());
+		REQUIRE(map.begin() == map.end());
+		REQUIRE(map.bucket_count() == slots);
+	}
+}
+
+template<const int d>
+void CheckPolynomialBackends(const monOrder k) {
+	Polynomial<d> p1, p2;
+	Polynomial<d, OpenHashMap<monIndex, double>> q1, q2;
+	for (monIndex alpha = 0; alpha < Poly<d>::SpaceDim(k); ++alpha) {
+		p1.Terms[alpha] = q1.Terms[alpha] = 1.0 / (alpha + 1.0);
+		if (alpha % 2 == 0)
+			p2.Terms[alpha] = q2.Terms[alpha] = (alpha % 4 == 0 ? 1.0 : -1.0);
+	}
+	p1 *= p2;
+	q1 *= q2;
+	p1 += p2;
+	q1 += q2;
+	REQUIRE(q1.Terms.size() == p1.Terms.size());
+	REQUIRE(q1.Order() == p1.Order());
+	for (const auto& [index, scalar] : p1.Terms)
+		REQUIRE_THAT(q1.Terms.at(index), Catch::Matchers::WithinAbs(scalar, 1e-12));
+}
+
+TEST_CASE("Polynomial Backends") {
+	SECTION("2D") { CheckPolynomialBackends<2>(6); }
+	SECTION("3D") { CheckPolynomialBackends<3>(4); }
+	SECTION("(x+1)(x-1)") {
+		Polynomial<2, OpenHashMap<monIndex, double>> p1, p2;
+		p1.Terms[1] = 1.;
+		p1.Terms[0] = 1.;
+		p2.Terms[1] = 1.;
+		p2.Terms[0] = -1.;
+		p1 *= p2;
+		REQUIRE(p1.Terms.at(3) == 1.0);
+		REQUIRE(p1.Terms.at(0) == -1.0);
+		REQUIRE(p1.Terms.size() == 2);
+		REQUIRE(p1.Order() == 2);
+	}
+}
+
+// Memory resource counting the allocations requested from it.
+class CountingResource : public std::pmr::memory_resource {
+public:
+	size_t Allocations = 0;
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		++Allocations;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Products and sums of the polynomials of an element loop, returning the allocations made after the first element.
+template<const int d, typename Map>
+size_t SteadyStateAllocations(CountingResource& counter, const typename Map::allocator_type& allocator) {
+	Polynomial<d, Map> a(allocator), b(allocator), product(allocator), sum(allocator);
+	size_t warm = 0;
+	for (int element = 0; element < 10; ++element) {
+		a.Terms.clear();
+		b.Terms.clear();
+		for (monIndex alpha = 0; alpha < Poly<d>::SpaceDim(3); ++alpha) {
+			a.Terms[alpha] = 1.0 + element;
+			b.Terms[alpha] = 1.0 / (alpha + 1.0);
+		}
+		MultiplyInto(product, a, b);
+		AddInto(sum, sum, product);
+		if (element == 1)
+			warm = counter.Allocations;
+	}
+	REQUIRE(product.Terms.size() == (size_t)Poly<d>::SpaceDim(6));
+	return counter.Allocations - warm;
+}
+
+TEST_CASE("In-place Polynomial Arithmetic") {
+	SECTION("Into and aliasing") {
+		pnl2D p, q;
+		p.Terms[1] = 1.;
+		p.Terms[0] = 1.;   // x + 1
+		q.Terms[1] = 1.;
+		q.Terms[0] = -1.;  // x - 1
+		pnl2D out;
+		out.Terms[7] = 5.; // overwritten
+		MultiplyInto(out, p, q);
+		REQUIRE(out.Terms.size() == 2);
+		REQUIRE(out.Terms.at(3) == 1.);
+		REQUIRE(out.Terms.at(0) == -1.);
+		MultiplyInto(p, p, p); // (x + 1)^2
+		REQUIRE(p.Terms.size() == 3);
+		REQUIRE(p.Terms.at(1) == 2.);
+		AddInto(out, out, p);  // 2x^2 + 2x
+		REQUIRE(out.Terms.size() == 2);
+		AddInto(q, p, q);      // x^2 + 3x
+		REQUIRE(q.Terms.size() == 2);
+		REQUIRE(q.Terms.at(1) == 3.);
+		const pnl2D r = p + q;
+		REQUIRE(r.Terms.at(3) == 2.);
+		REQUIRE(r.Terms.at(1) == 5.);
+		REQUIRE(r.Terms.at(0) == 1.);
+	}
+	SECTION("No allocations with a pool") {
+		CountingResource counter;
+		std::pmr::unsynchronized_pool_resource pool(&counter);
+		REQUIRE(SteadyStateAllocations<2, std::pmr::unordered_map<monIndex, double>>(counter, &pool) == 0);
+		REQUIRE(SteadyStateAllocations<3, std::pmr::unordered_map<monIndex, double>>(counter, &pool) == 0);
+	}
+	SECTION("No allocations with OpenHashMap") {
+		using PmrOpenHashMap = OpenHashMap<monIndex, double, std::pmr::polymorphic_allocator<std::pair<monIndex, double>>>;
+		CountingResource counter;
+		REQUIRE(SteadyStateAllocations<2, PmrOpenHashMap>(counter, &counter) == 0);
+		REQUIRE(SteadyStateAllocations<3, PmrOpenHashMap>(counter, &counter) == 0);
+		REQUIRE(counter.Allocations > 0);
+	}
+	SECTION("Results keep the allocator") {
+		CountingResource counter;
+		PmrPolynomial<2> p(&counter);
+		p.Terms[1] = 1.;
+		const size_t before = counter.Allocations;
+		const PmrPolynomial<2> q = p * p + p;
+		REQUIRE(q.Terms.get_allocator().resource() == &counter);
+		REQUIRE(counter.Allocations > before);
+	}
+}
+
+TEST_CASE("Truncated Products") {
+	SECTION("2D Polynomials") {
+		const int d = 2;
+		// (1 + x + y + xy)(1 - x + y^2) = 1 + y - x^2 + y^2 - x^2y + xy^2 + y^3 + xy^3, the terms in x and xy cancelling
+		DensePolynomial<d> p1(2), p2(2);
+		p1.Coefficients = { 1., 1., 1., 0., 1., 0. };
+		p2.Coefficients = { 1., -1., 0., 0., 0., 1. };
+		Polynomial<d> s1, s2;
+		s1.Terms[0] = 1.; s1.Terms[1] = 1.; s1.Terms[2] = 1.; s1.Terms[4] = 1.;
+		s2.Terms[0] = 1.; s2.Terms[1] = -1.; s2.Terms[5] = 1.;
+		const FlatPolynomial<d> f1({ { 0, 1. }, { 1, 1. }, { 2, 1. }, { 4, 1. } }), f2({ { 0, 1. }, { 1, -1. }, { 5, 1. } });
+		SECTION("K below the orders of the factors") {
+			REQUIRE(MultiplyTruncated(p1, p2, 1).Coefficients == std::vector<double>{ 1., 0., 1. });
+			const Polynomial<d> sparse = MultiplyTruncated(s1, s2, 1);
+			REQUIRE(sparse.Terms.size() == 2);
+			REQUIRE(sparse.Terms.at(0) == 1.);
+			REQUIRE(sparse.Terms.at(2) == 1.);
+			REQUIRE(MultiplyTruncated(f1, f2, 1).Terms == std::vector<std::pair<monIndex, double>>{ { 0, 1. }, { 2, 1. } });
+		}
+		SECTION("K between the orders of the factors and of the product") {
+			const DensePolynomial<d> dense = MultiplyTruncated(p1, p2, 3);
+			REQUIRE(dense.Order() == 3);
+			REQUIRE(dense.Coefficients == std::vector<double>{ 1., 0., 1., -1., 0., 1., 0., -1., 1., 1. });
+			const Polynomial<d> sparse = MultiplyTruncated(s1, s2, 3);
+			REQUIRE(sparse.Terms.size() == 7);
+			REQUIRE(sparse.Terms.at(3) == -1.);
+			REQUIRE(sparse.Terms.at(7) == -1.);
+			REQUIRE(sparse.Terms.count(13) == 0);
+			REQUIRE(MultiplyTruncated(f1, f2, 3).Terms == std::vector<std::pair<monIndex, double>>{ { 0, 1. }, { 2, 1. }, { 3, -1. }, { 5, 1. }, { 7, -1. }, { 8, 1. }, { 9, 1. } });
+		}
+		SECTION("K above the order of the product") {
+			const DensePolynomial<d> dense = MultiplyTruncated(p1, p2, 6);
+			REQUIRE(dense.Order() == 4);
+			REQUIRE(dense.Coefficients == std::vector<double>{ 1., 0., 1., -1., 0., 1., 0., -1., 1., 1., 0., 0., 0., 1., 0. });
+			REQUIRE(dense.Coefficients == (p1 * p2).Coefficients);
+			const Polynomial<d> sparse = MultiplyTruncated(s1, s2, 6);
+			REQUIRE(sparse.Terms.size() == 8);
+			REQUIRE(sparse.Terms.at(13) == 1.);
+			REQUIRE(MultiplyTruncated(f1, f2, 6).Terms.size() == 8);
+		}
+		SECTION("Constant and negative K") {
+			REQUIRE(MultiplyTruncated(p1, p2, 0).Coefficients == std::vector<double>{ 1. });
+			REQUIRE(MultiplyTruncated(s1, s2, 0).Terms.size() == 1);
+			REQUIRE(MultiplyTruncated(p1, p2, -1).Order() == -1);
+			REQUIRE(MultiplyTruncated(s1, s2, -1).Terms.empty());
+			REQUIRE(MultiplyTruncated(f1, f2, -1).Terms.empty());
+		}
+	}
+	SECTION("3D Polynomials") {
+		const int d = 3;
+		// x^2 (1 + z) = x^2 + x^2z, nothing of it being below order 2
+		DensePolynomial<d> p1(2), p2(1);
+		p1.Coefficients = { 0., 0., 0., 0., 1., 0., 0., 0., 0., 0. };
+		p2.Coefficients = { 1., 0., 0., 1. };
+		Polynomial<d> s1, s2;
+		s1.Terms[4] = 1.;
+		s2.Terms[0] = 1.; s2.Terms[3] = 1.;
+		REQUIRE(MultiplyTruncated(p1, p2, 1).Coefficients == std::vector<double>{ 0., 0., 0., 0. });
+		REQUIRE(MultiplyTruncated(s1, s2, 1).Terms.empty());
+		REQUIRE(MultiplyTruncated(p1, p2, 2).Coefficients == p1.Coefficients);
+		const Polynomial<d> sparse = MultiplyTruncated(s1, s2, 3);
+		REQUIRE(sparse.Terms.size() == 2);
+		REQUIRE(sparse.Terms.at(4) == 1.);
+		REQUIRE(sparse.Terms.at(12) == 1.);
+	}
+}
+
+template<const int d, typename Map>
+void CheckLazyExpressions(const monOrder k) {
+	Polynomial<d, Map> a, b, c, e;
+	for (monIndex alpha = 0; alpha < Poly<d>::SpaceDim(k); ++alpha) {
+		a.Terms[alpha] = 1.0 / (alpha + 1.0);
+		if (alpha % 2 == 0)
+			b.Terms[alpha] = 1.0 - alpha;
+		if (alpha % 3 == 0)
+			c.Terms[alpha] = 0.5 * alpha;
+		e.Terms[alpha] = (alpha % 2 == 0 ? 1.0 : -1.0);
+	}
+	auto compare = [](const Polynomial<d, Map>& lazy, const Polynomial<d, Map>& eager) {
+		REQUIRE(lazy.Terms.size() == eager.Terms.size());
+		for (const auto& [index, scalar] : eager.Terms)
+			REQUIRE_THAT(lazy.Terms.at(index), Catch::Matchers::WithinAbs(scalar, 1e-12));
+	};
+
+	Polynomial<d, Map> lazy;
+	lazy = Lazy(a) * Lazy(b) + Lazy(c) * Lazy(e);
+	compare(lazy, a * b + c * e);
+
+	lazy = 2.0 * Lazy(a) - Lazy(b) * 0.5;
+	Polynomial<d, Map> half, minusOne;
+	half.Terms[0] = 0.5;
+	minusOne.Terms[0] = -1.0;
+	compare(lazy, (a + a) + b * half * minusOne);
+
+	// Operands of products which are expressions themselves
+	lazy = (Lazy(a) + Lazy(b)) * (Lazy(c) - Lazy(e));
+	compare(lazy, (a + b) * (c + e * minusOne));
+
+	// Destination in the expression
+	Polynomial<d, Map> aliased = a;
+	aliased = Lazy(aliased) * Lazy(b) + Lazy(aliased);
+	compare(aliased, a * b + a);
+	aliased += Lazy(aliased) * Lazy(c);
+	compare(aliased, (a * b + a) + (a * b + a) * c);
+
+	// Cancellation is pruned once, at the end
+	lazy = Lazy(a) * Lazy(b) - Lazy(b) * Lazy(a);
+	REQUIRE(lazy.Terms.empty());
+}
+
+TEST_CASE("Lazy Expressions") {
+	SECTION("2D") { CheckLazyExpressions<2, std::unordered_map<monIndex, double>>(4); }
+	SECTION("3D") { CheckLazyExpressions<3, std::unordered_map<monIndex, double>>(3); }
+	SECTION("OpenHashMap") { CheckLazyExpressions<2, OpenHashMap<monIndex, double>>(4); }
+}
+
+TEST_CASE("Batch Polynomial Products") {
+	SECTION("2D Polynomials") {
+		const int d = 2;
+		// (1 + e x)(e - y) = e + e^2 x - y - e xy for e = 0, ..., 4, a count which is not a multiple of the vector width
+		const size_t count = 5;
+		DensePolynomialBatch<d> b1(1, count), b2(1, count);
+		for (size_t e = 0; e < count; ++e) {
+			DensePolynomial<d> p1(1), p2(1);
+			p1.Coefficients = { 1., double(e), 0. };
+			p2.Coefficients = { double(e), 0., -1. };
+			b1.Set(e, p1);
+			b2.Set(e, p2);
+		}
+		// Coefficients[alpha * Count + e]
+		REQUIRE(b1.Coefficients == std::vector<double>{ 1., 1., 1., 1., 1., 0., 1., 2., 3., 4., 0., 0., 0., 0., 0. });
+		REQUIRE(b2.Get(3).Coefficients == std::vector<double>{ 3., 0., -1. });
+		SECTION("Full product") {
+			const ProductSchedule<d> schedule(1, 1);
+			REQUIRE(schedule.TargetOrder == 2);
+			REQUIRE(schedule.Size() == 9);
+			DensePolynomialBatch<d> product;
+			MultiplyInto(product, b1, b2, schedule);
+			REQUIRE(product.Order == 2);
+			REQUIRE(product.Count == count);
+			for (size_t e = 0; e < count; ++e) {
+				const double c = double(e);
+				REQUIRE(product.Get(e).Coefficients == std::vector<double>{ c, c * c, -1., 0., -c, 0. });
+			}
+			// The output is resized and overwritten when reused
+			MultiplyInto(product, b1, b1, schedule);
+			REQUIRE(product.Get(4).Coefficients == std::vector<double>{ 1., 8., 0., 16., 0., 0. });
+		}
+		SECTION("Truncated product") {
+			// Products of orders 0 and 1 only, sorted by target: 1*1, 1*x, x*1, 1*y, y*1
+			const ProductSchedule<d> schedule(1, 1, 1);
+			REQUIRE(schedule.TargetOrder == 1);
+			REQUIRE(schedule.Target == std::vector<monIndex>{ 0, 1, 1, 2, 2 });
+			DensePolynomialBatch<d> product;
+			MultiplyInto(product, b1, b2, schedule);
+			REQUIRE(product.Order == 1);
+			for (size_t e = 0; e < count; ++e)
+				REQUIRE(product.Get(e).Coefficients == std::vector<double>{ double(e), double(e * e), -1. });
+			MultiplyInto(product, b1, b2, ProductSchedule<d>(1, 1, 0));
+			REQUIRE(product.Coefficients == std::vector<double>{ 0., 1., 2., 3., 4. });
+		}
+	}
+	SECTION("Single polynomial") {
+		const int d = 3;
+		// (x + z)(y - 2) = -2x + xy - 2z + yz
+		DensePolynomialBatch<d> b1(1, 1), b2(1, 1);
+		b1.Coefficients = { 0., 1., 0., 1. };
+		b2.Coefficients = { -2., 0., 1., 0. };
+		DensePolynomialBatch<d> product;
+		MultiplyInto(product, b1, b2, ProductSchedule<d>(1, 1));
+		REQUIRE(product.Coefficients == std::vector<double>{ 0., -2., 0., -2., 0., 1., 0., 0., 1., 0. });
+	}
+}
+
+TEST_CASE("Parallel Products") {
+	SECTION("1D Polynomials") {
+		const int d = 1;
+		// (1 + x + x^2 + x^3)^2 = 1 + 2x + 3x^2 + 4x^3 + 3x^4 + 2x^5 + x^6, 7 orders that 2, 3 and 4 threads split unevenly
+		DensePolynomial<d> p(3);
+		p.Coefficients = { 1., 1., 1., 1. };
+		for (const int nThreads : { 1, 2, 3, 4, 7, 64, 0 })
+			REQUIRE(MultiplyParallel(p, p, nThreads).Coefficients == std::vector<double>{ 1., 2., 3., 4., 3., 2., 1. });
+	}
+	SECTION("2D Polynomials") {
+		const int d = 2;
+		// (x + y)(x - y) = x^2 - y^2, all the work landing on the last of the 3 orders
+		DensePolynomial<d> p1(1), p2(1);
+		p1.Coefficients = { 0., 1., 1. };
+		p2.Coefficients = { 0., 1., -1. };
+		for (const int nThreads : { 1, 2, 3 })
+			REQUIRE(MultiplyParallel(p1, p2, nThreads).Coefficients == std::vector<double>{ 0., 0., 0., 1., 0., -1. });
+	}
+	SECTION("Constants") {
+		const int d = 3;
+		DensePolynomial<d> p1(0), p2(0);
+		p1.Coefficients = { 3. };
+		p2.Coefficients = { 2. };
+		// More threads than orders
+		REQUIRE(MultiplyParallel(p1, p2, 4).Coefficients == std::vector<double>{ 6. });
+		REQUIRE(MultiplyParallel(DensePolynomial<d>(), p2, 4).Order() == -1);
+	}
+	SECTION("Nested calls") {
+		// Each task runs its inner tasks in its own thread instead of waiting for the pool
+		std::vector<int> calls(12, 0);
+		_ParallelFor(3, [&](const int i) {
+			_ParallelFor(4, [&](const int j) { ++calls[4 * i + j]; });
+		});
+		for (const int c : calls)
+			REQUIRE(c == 1);
+	}
+	SECTION("Exceptions") {
+		for (const int thrower : { 0, 2 }) {
+			std::vector<int> done(4, 0);
+			REQUIRE_THROWS_AS(_ParallelFor(4, [&](const int i) {
+				if (i == thrower)
+					throw std::runtime_error("task");
+				done[i] = 1;
+			}), std::runtime_error);
+			// The other tasks ran to completion before the exception was rethrown
+			for (int i = 0; i < 4; ++i)
+				REQUIRE(done[i] == (i == thrower ? 0 : 1));
+		}
+		std::vector<int> done(4, 0);
+		_ParallelFor(4, [&](const int i) { done[i] = 1; });
+		REQUIRE(done == std::vector<int>{ 1, 1, 1, 1 });
+	}
+	SECTION("Concurrent calls") {
+		// (1 + x)(1 - x) = 1 - x^2, from two threads sharing the pool
+		DensePolynomial<1> p1(1), p2(1);
+		p1.Coefficients = { 1., 1. };
+		p2.Coefficients = { 1., -1. };
+		std::vector<std::vector<double>> results(2);
+		std::vector<std::thread> callers;
+		for (int c = 0; c < 2; ++c)
+			callers.emplace_back([&, c]() {
+				for (int repeat = 0; repeat < 50; ++repeat)
+					results[c] = MultiplyParallel(p1, p2, 2).Coefficients;
+			});
+		for (std::thread& caller : callers)
+			caller.join();
+		for (const std::vector<double>& result : results)
+			REQUIRE(result == std::vector<double>{ 1., 0., -1. });
+	}
+}
+
+TEST_CASE("Change of Variables") {
+	SECTION("1D Polynomials") {
+		const int d = 1;
+		DensePolynomial<d> dense(3);
+		dense.Coefficients = { 0., 0., 0., 1. };
+		Polynomial<d> sparse;
+		sparse.Terms[3] = 1.;
+		SECTION("Translation") {
+			// (x - 2)^3 = -8 + 12x - 6x^2 + x^3
+			REQUIRE(dense.Translate({ 2. }).Coefficients == std::vector<double>{ -8., 12., -6., 1. });
+			REQUIRE(DensePolynomial<d>(sparse.Translate({ 2. })).Coefficients == std::vector<double>{ -8., 12., -6., 1. });
+		}
+		SECTION("Scaling") {
+			// (x / 2)^3 = x^3 / 8
+			REQUIRE(dense.Scale(2.).Coefficients == std::vector<double>{ 0., 0., 0., 0.125 });
+			REQUIRE(sparse.Scale(2.).Terms.size() == 1);
+			REQUIRE(sparse.Scale(2.).Terms.at(3) == 0.125);
+		}
+		SECTION("Local coordinates") {
+			// ((x - 1) / 2)^3 = (-1 + 3x - 3x^2 + x^3) / 8
+			REQUIRE(dense.Scale(2.).Translate({ 1. }).Coefficients == std::vector<double>{ -0.125, 0.375, -0.375, 0.125 });
+			REQUIRE(DensePolynomial<d>(sparse.Scale(2.).Translate({ 1. })).Coefficients == std::vector<double>{ -0.125, 0.375, -0.375, 0.125 });
+		}
+	}
+	SECTION("3D Polynomials") {
+		const int d = 3;
+		// (x - 1)(y - 2)(z - 3) = xyz - 3xy - 2xz - yz + 6x + 3y + 2z - 6
+		Polynomial<d> p;
+		p.Terms[Poly<d>::Index({ 1, 1, 1 })] = 1.;
+		const Polynomial<d> q = p.Translate({ 1., 2., 3. });
+		REQUIRE(q.Terms.size() == 8);
+		REQUIRE(q.Terms.at(Poly<d>::Index({ 1, 1, 1 })) == 1.);
+		REQUIRE(q.Terms.at(Poly<d>::Index({ 1, 1, 0 })) == -3.);
+		REQUIRE(q.Terms.at(Poly<d>::Index({ 1, 0, 1 })) == -2.);
+		REQUIRE(q.Terms.at(Poly<d>::Index({ 0, 1, 1 })) == -1.);
+		REQUIRE(q.Terms.at(Poly<d>::Index({ 1, 0, 0 })) == 6.);
+		REQUIRE(q.Terms.at(Poly<d>::Index({ 0, 1, 0 })) == 3.);
+		REQUIRE(q.Terms.at(Poly<d>::Index({ 0, 0, 1 })) == 2.);
+		REQUIRE(q.Terms.at(0) == -6.);
+		REQUIRE(DensePolynomial<d>(p).Translate({ 1., 2., 3. }).Coefficients == DensePolynomial<d>(q).Coefficients);
+		// xyz / (0.5^3) = 8 xyz, and constants are unchanged
+		REQUIRE(p.Scale(0.5).Terms.at(Poly<d>::Index({ 1, 1, 1 })) == 8.);
+		DensePolynomial<d> constant(0);
+		constant.Coefficients = { 4. };
+		REQUIRE(constant.Scale(0.5).Translate({ 1., 2., 3. }).Coefficients == std::vector<double>{ 4. });
+	}
+	SECTION("(x+y)^2") {
+		// (x - 1 + y)^2 = 1 - 2x - 2y + x^2 + 2xy + y^2
+		Polynomial<2> p;
+		p.Terms[3] = 1.; p.Terms[4] = 2.; p.Terms[5] = 1.;
+		const Polynomial<2> q = p.Translate({ 1., 0. });
+		REQUIRE(DensePolynomial<2>(q).Coefficients == std::vector<double>{ 1., -2., -2., 1., 2., 1. });
+		REQUIRE(DensePolynomial<2>(p).Translate({ 1., 0. }).Coefficients == std::vector<double>{ 1., -2., -2., 1., 2., 1. });
+		REQUIRE(DensePolynomial<2>(p.Scale(2.)).Coefficients == std::vector<double>{ 0., 0., 0., 0.25, 0.5, 0.25 });
+	}
+	SECTION("Empty") {
+		REQUIRE(Polynomial<3>().Translate({ 1., 2., 3. }).Terms.empty());
+		REQUIRE(DensePolynomial<3>().Translate({ 1., 2., 3. }).Order() == -1);
+		REQUIRE(DensePolynomial<3>().Scale(2.).Order() == -1);
+	}
+}
+
+TEST_CASE("Compiled Polynomials") {
+	SECTION("2D Polynomials") {
+		const int d = 2;
+		// 1 + 2x - y + x^2y needs 1, x, y and two monomials of order 2 and 3 to reach x^2y
+		Polynomial<d> p;
+		p.Terms[0] = 1.; p.Terms[1] = 2.; p.Terms[2] = -1.; p.Terms[7] = 1.;
+		const CompiledPolynomial<d> fromTerms(p.Terms), fromFlat(FlatPolynomial<d>(p).Terms);
+		const std::vector<double> coefficients{ 1., 2., -1., 0., 0., 0., 0., 1. };
+		const CompiledPolynomial<d> fromDense(coefficients.data(), (monIndex)coefficients.size());
+		REQUIRE(fromTerms.Size() == 5);
+		REQUIRE(fromDense.Size() == 5);
+		REQUIRE(fromTerms(std::array<double, d>{ 2., 3. }) == 1. + 4. - 3. + 12.);
+
+		// 9 points, one full block and a block with a single point, x = -1, -0.5, ..., 3 and y = 1 - x
+		const size_t nPoints = 9;
+		std::vector<double> points(d * nPoints);
+		for (size_t i = 0; i < nPoints; ++i) {
+			points[i] = -1. + 0.5 * i;
+			points[nPoints + i] = 2. - 0.5 * i;
+		}
+		std::vector<double> batch(nPoints), withWorkspace(nPoints), workspace(fromDense.WorkspaceSize());
+		fromTerms.Evaluate(points.data(), nPoints, batch.data());
+		fromDense.Evaluate(points.data(), nPoints, withWorkspace.data(), workspace.data());
+		for (size_t i = 0; i < nPoints; ++i) {
+			const double x = points[i], y = points[nPoints + i];
+			const double expected = 1. + 2. * x - y + x * x * y;
+			REQUIRE(batch[i] == expected);
+			REQUIRE(withWorkspace[i] == expected);
+			REQUIRE(fromFlat(std::array<double, d>{ x, y }) == expected);
+		}
+	}
+	SECTION("3D Polynomials") {
+		const int d = 3;
+		// xyz - 3z^2 at (1, 1, 1), (2, 0.5, 1) and (-1, 2, 0.5), fewer points than a block
+		Polynomial<d> p;
+		p.Terms[Poly<d>::Index({ 1, 1, 1 })] = 1.;
+		p.Terms[Poly<d>::Index({ 0, 0, 2 })] = -3.;
+		const CompiledPolynomial<d> compiled(p.Terms);
+		const std::vector<double> points{ 1., 2., -1., 1., 0.5, 2., 1., 1., 0.5 };
+		std::vector<double> out(3);
+		compiled.Evaluate(points.data(), 3, out.data());
+		REQUIRE(out == std::vector<double>{ 1. - 3., 1. - 3., -1. - 0.75 });
+	}
+	SECTION("Sparse") {
+		// x^5 y^3 - 2 y^2 only needs 1, y, y^2, y^3, x y^3, ..., x^5 y^3
+		Polynomial<2> p;
+		p.Terms[Poly<2>::Index({ 5, 3 })] = 1.;
+		p.Terms[Poly<2>::Index({ 0, 2 })] = -2.;
+		const CompiledPolynomial<2> compiled(p.Terms);
+		REQUIRE(compiled.Size() == 9);
+		const std::array<double, 2> x{ 2., 0.5 };
+		REQUIRE(compiled(x) == 32. * 0.125 - 2. * 0.25);
+	}
+	SECTION("Zero") {
+		const CompiledPolynomial<3> compiled(Polynomial<3>().Terms);
+		const std::vector<double> points(3 * 4, 1.);
+		std::vector<double> out(4, 1.);
+		compiled.Evaluate(points.data(), 4, out.data());
+		REQUIRE(out == std::vector<double>(4, 0.));
+		REQUIRE(compiled(points.data()) == 0.);
+	}
+}
+
 TEST_CASE("Triangle Quadrature") {
 	SECTION("Size of quadrature"){
 		for (mnl::monOrder k = 0; k <= 14; ++k)